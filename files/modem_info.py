@@ -2,9 +2,27 @@
 # Copyright (C) 2025 zzzz0317
 
 import json
+import struct
 import subprocess
+import sys
 
-def get_modem_info():
+# --serve reply format, keep in sync with src/modem_record.h
+RECORD_MAGIC = b"XGPM"
+RECORD_VERSION = 1
+RECORD_INT = 1
+RECORD_STRING = 2
+FIELD_IDS = {
+    "revision": 1, "temperature": 2, "voltage": 3, "connect": 4, "sim": 5,
+    "isp": 6, "cqi": 7, "ambr": 8, "networkmode": 9,
+}
+SIGNAL_FIELD_BASE = 0x10
+VALUE_SIZE = 64  # DEFAULT_VALUE_SIZE in src/metrics.h, including the NUL
+SIGNAL_FIELDS = {
+    "name": (0, RECORD_STRING), "value": (1, RECORD_INT), "min": (2, RECORD_INT),
+    "max": (3, RECORD_INT), "unit": (4, RECORD_STRING),
+}
+
+def collect_modem_info():
     try:
         result = subprocess.run(
             ['/usr/libexec/rpcd/modem_ctrl', 'call', 'info'],
@@ -23,7 +41,7 @@ def get_modem_info():
     
     result = {}
     result_progress = {}
-    result_txt = []
+    result_txt = []  # (key, value) pairs in output order
     
     data = data.get("info", [])
     if not isinstance(data, list):
@@ -86,35 +104,90 @@ def get_modem_info():
     else:
         result['AMBR'] = f"{result.get('AMBR DL')}/{result.get('AMBR UL')}"
     
-    result_txt.append(f"revision:{result.get('revision', 'unknown')}")
-    result_txt.append(f"temperature:{result.get('temperature', 'unknown')}")
-    result_txt.append(f"voltage:{result.get('voltage', 'unknown')}")
-    result_txt.append(f"connect:{result.get('connect_status', default_unknown_value_relative_to_sim_status)}")
-    result_txt.append(f"sim:{sim_status}")
-    result_txt.append(f"isp:{result.get('ISP', default_unknown_value_relative_to_sim_status)}")
-    result_txt.append(f"cqi:{result['CQI']}")
-    result_txt.append(f"ambr:{result['AMBR']}")
-    result_txt.append(f"networkmode:{result.get('network_mode', default_unknown_value_relative_to_sim_status)}")
+    result_txt.append(("revision", f"{result.get('revision', 'unknown')}"))
+    result_txt.append(("temperature", f"{result.get('temperature', 'unknown')}"))
+    result_txt.append(("voltage", f"{result.get('voltage', 'unknown')}"))
+    result_txt.append(("connect", f"{result.get('connect_status', default_unknown_value_relative_to_sim_status)}"))
+    result_txt.append(("sim", f"{sim_status}"))
+    result_txt.append(("isp", f"{result.get('ISP', default_unknown_value_relative_to_sim_status)}"))
+    result_txt.append(("cqi", f"{result['CQI']}"))
+    result_txt.append(("ambr", f"{result['AMBR']}"))
+    result_txt.append(("networkmode", f"{result.get('network_mode', default_unknown_value_relative_to_sim_status)}"))
     
     result_progress_keys = list(result_progress.keys())
     
     for i in range(3):
         try:
             d = result_progress_keys.pop(0)
-            result_txt.append(f"signal{i}name:{d}")
-            result_txt.append(f"signal{i}value:{result_progress[d]['value']}")
-            result_txt.append(f"signal{i}min:{result_progress[d]['min_value']}")
-            result_txt.append(f"signal{i}max:{result_progress[d]['max_value']}")
-            result_txt.append(f"signal{i}unit:{result_progress[d]['value']}/{result_progress[d]['max_value']}{result_progress[d]['unit']}")
+            result_txt.append((f"signal{i}name", f"{d}"))
+            result_txt.append((f"signal{i}value", f"{result_progress[d]['value']}"))
+            result_txt.append((f"signal{i}min", f"{result_progress[d]['min_value']}"))
+            result_txt.append((f"signal{i}max", f"{result_progress[d]['max_value']}"))
+            result_txt.append((f"signal{i}unit", f"{result_progress[d]['value']}/{result_progress[d]['max_value']}{result_progress[d]['unit']}"))
         except IndexError:
-            result_txt.append(f"signal{i}name:-")
-            result_txt.append(f"signal{i}value:0")
-            result_txt.append(f"signal{i}min:0")
-            result_txt.append(f"signal{i}max:0")
-            result_txt.append(f"signal{i}unit:-")
+            result_txt.append((f"signal{i}name", "-"))
+            result_txt.append((f"signal{i}value", "0"))
+            result_txt.append((f"signal{i}min", "0"))
+            result_txt.append((f"signal{i}max", "0"))
+            result_txt.append((f"signal{i}unit", "-"))
     
-    return "\n".join(result_txt)
+    return result_txt
+
+def get_modem_info():
+    info = collect_modem_info()
+    if info is None:
+        return None
+    return "\n".join(f"{k}:{v}" for k, v in info)
+
+def to_int(value):
+    # same result as atoi() for the numbers modem_ctrl reports, e.g. "-19.5" -> -19
+    try:
+        return max(-2**31, min(2**31 - 1, int(float(value))))
+    except (ValueError, OverflowError):
+        return 0
+
+def truncate_utf8(value, limit):
+    # cut at a character boundary, the decoder would cut mid-sequence
+    data = value.encode()
+    if len(data) <= limit:
+        return data
+    return data[:limit].decode(errors="ignore").encode()
+
+def pack_record(key, value):
+    if key in FIELD_IDS:
+        field, record_type = FIELD_IDS[key], RECORD_STRING
+    else:
+        # signal<n><field>
+        offset, record_type = SIGNAL_FIELDS[key[7:]]
+        field = SIGNAL_FIELD_BASE + int(key[6]) * 8 + offset
+    if record_type == RECORD_INT:
+        data = struct.pack("<i", to_int(value))
+    else:
+        data = truncate_utf8(value, VALUE_SIZE - 1)
+    return struct.pack("<BBH", field, record_type, len(data)) + data
+
+def pack_frame(info):
+    records = [pack_record(k, v) for k, v in info or []]
+    body = b"".join(records)
+    return struct.pack("<4sBBH", RECORD_MAGIC, RECORD_VERSION, len(records), len(body)) + body
+
+def serve():
+    # one request per line on stdin, one record frame per reply on stdout
+    out = sys.stdout.buffer
+    for line in sys.stdin:
+        if line.strip() != "info":
+            continue
+        try:
+            info = collect_modem_info()
+        except Exception as e:
+            print(f"modem_info: {e!r}", file=sys.stderr)
+            info = None
+        out.write(pack_frame(info))
+        out.flush()
 
 if __name__ == '__main__':
-    info = get_modem_info()
-    print(info)
\ No newline at end of file
+    if "--serve" in sys.argv[1:]:
+        serve()
+    else:
+        info = get_modem_info()
+        print(info)
\ No newline at end of file
@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+/*
+ * zz_xgp_screen_bench: renders the carousel into memory with synthetic
+ * metrics and reports how long each frame took to render, how many pixels
+ * it flushed and how much of the LVGL heap was used.
+ *
+ *   zz_xgp_screen_bench [-c cycles] [-f frames.csv]
+ *
+ * LVGL runs on a virtual clock advanced by one refresh period per frame,
+ * so every run renders the same frames and only the timing varies. Each
+ * frame's framebuffer is hashed, which lets builds with different draw
+ * kernels be checked for identical output (see bench_neon.sh).
+ */
+
+#include "lvgl/lvgl.h"
+#include "ui/ui.h"
+#include "fbdisp.h"
+#include "ui_apply.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_WIDTH 320
+#define BENCH_HEIGHT 240
+#define BENCH_SAMPLE_PERIOD_MS 1000
+#define BENCH_MAX_VIRTUAL_MS (30 * 60 * 1000)
+
+struct bench_screen
+{
+    lv_obj_t **screen;
+    const char *name;
+    uint32_t frames;
+    uint64_t render_us;
+    uint64_t max_us;
+    uint64_t pixels;
+};
+
+// carousel order
+static struct bench_screen screens[] = {
+    {&ui_Boot, "Boot"},
+    {&ui_Splash, "Splash"},
+    {&ui_SystemInfo, "SystemInfo"},
+    {&ui_SystemStatus, "SystemStatus"},
+    {&ui_NetworkInfo, "NetworkInfo"},
+    {&ui_Throughput, "Throughput"},
+    {&ui_ModemInfo, "ModemInfo"},
+    {&ui_ModemSignal, "ModemSignal"},
+};
+
+#define BENCH_SCREEN_COUNT ((int)(sizeof(screens) / sizeof(screens[0])))
+
+static uint32_t virtual_ms = 0;
+static uint16_t framebuffer[BENCH_WIDTH * BENCH_HEIGHT];
+static uint64_t frame_pixels = 0;
+static uint32_t frame_flushes = 0;
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ p[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t bench_tick(void)
+{
+    return virtual_ms;
+}
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static void bench_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++)
+    {
+        memcpy(&framebuffer[y * BENCH_WIDTH + area->x1], px_map + (size_t)(y - area->y1) * w * 2, (size_t)w * 2);
+    }
+    frame_pixels += (uint64_t)w * lv_area_get_height(area);
+    frame_flushes++;
+    lv_display_flush_ready(disp);
+}
+
+static void create_display(void)
+{
+    uint32_t buf_size = BENCH_WIDTH * FBDISP_BUFFER_ROWS * sizeof(uint16_t);
+    void *buf = malloc(buf_size);
+    if (buf == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    // same render mode and buffer as the device, see fbdisp.c
+    lv_display_t *disp = lv_display_create(BENCH_WIDTH, BENCH_HEIGHT);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, bench_flush);
+}
+
+/* Plausible values that change every second like the real ones do */
+static void synth_snapshot(struct metrics_snapshot *s, uint32_t sec)
+{
+    s->seq = sec + 1;
+    s->modem_seq = sec / 10 + 1;
+
+    snprintf(s->hostname, sizeof(s->hostname), "XGP-V3");
+    snprintf(s->sys_version, sizeof(s->sys_version), "ImmortalWrt 24.10.0");
+    snprintf(s->build_id, sizeof(s->build_id), "r28427-6df0e3d02a");
+    snprintf(s->kernel_version, sizeof(s->kernel_version), "6.6.73");
+    snprintf(s->load_avg, sizeof(s->load_avg), "0.%02u 0.%02u 0.%02u", (sec * 7) % 100, 40 + sec % 20, 35);
+    snprintf(s->memory, sizeof(s->memory), "%u / 1986 MB (%u%%)", 412 + sec % 64, (412 + sec % 64) * 100 / 1986);
+    snprintf(s->uptime, sizeof(s->uptime), "3天 %02u:%02u:%02u", (sec / 3600) % 24, (sec / 60) % 60, sec % 60);
+    snprintf(s->local_time, sizeof(s->local_time), "2025-06-01 %02u:%02u:%02u", 12 + (sec / 3600) % 12,
+             (sec / 60) % 60, sec % 60);
+    s->soc_temp_mc = 52000 + (int32_t)(sec % 30) * 100;
+    s->overheat = false;
+    snprintf(s->soc_temp, sizeof(s->soc_temp), "SoC %d.%d℃", s->soc_temp_mc / 1000, s->soc_temp_mc / 100 % 10);
+    snprintf(s->modem_ip, sizeof(s->modem_ip), "10.133.42.17");
+    snprintf(s->wan_ip, sizeof(s->wan_ip), "192.168.1.23");
+    snprintf(s->lan_ip, sizeof(s->lan_ip), "192.168.100.1");
+    snprintf(s->active_connect, sizeof(s->active_connect), "%u", 180 + (sec * 13) % 90);
+    snprintf(s->arp_count, sizeof(s->arp_count), "br-lan: %u", 5 + sec % 3);
+    s->cpu_count = 4;
+    for (int i = 0; i < 4; i++)
+    {
+        s->cpu[i].busy = (uint8_t)((sec * (i + 3) * 11) % 100);
+        s->cpu[i].softirq = (uint8_t)(s->cpu[i].busy / 4);
+    }
+    snprintf(s->throughput_modem, sizeof(s->throughput_modem), "%u.%u Mbps / %u kbps", 20 + sec % 40, sec % 10,
+             300 + (sec * 37) % 700);
+    snprintf(s->throughput_wan, sizeof(s->throughput_wan), "0 bps / 0 bps");
+    snprintf(s->throughput_lan, sizeof(s->throughput_lan), "%u.%u Mbps / %u kbps", 20 + sec % 40, sec % 10,
+             300 + (sec * 37) % 700);
+
+    struct modem_metrics *m = &s->modem;
+    snprintf(m->revision, sizeof(m->revision), "RM520NGLAAR03A03M4G");
+    snprintf(m->temperature, sizeof(m->temperature), "%u℃", 41 + sec / 10 % 5);
+    snprintf(m->voltage, sizeof(m->voltage), "3.8%u V", sec / 10 % 10);
+    snprintf(m->connect, sizeof(m->connect), "已连接");
+    snprintf(m->sim, sizeof(m->sim), "就绪");
+    snprintf(m->isp, sizeof(m->isp), "中国移动");
+    snprintf(m->cqi, sizeof(m->cqi), "%u", 9 + sec / 10 % 5);
+    snprintf(m->ambr, sizeof(m->ambr), "1000 / 200 Mbps");
+    snprintf(m->networkmode, sizeof(m->networkmode), "5G SA");
+    static const char *const signal_names[MODEM_SIGNAL_COUNT] = {"RSRP", "RSRQ", "SINR"};
+    static const int signal_ranges[MODEM_SIGNAL_COUNT][2] = {{-140, -44}, {-20, -3}, {-10, 30}};
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        struct modem_signal *sig = &m->signal[i];
+        snprintf(sig->name, sizeof(sig->name), "%s", signal_names[i]);
+        sig->min = signal_ranges[i][0];
+        sig->max = signal_ranges[i][1];
+        sig->value = sig->min + (int)((sec / 10 * (i + 5)) % (unsigned)(sig->max - sig->min));
+        snprintf(sig->unit, sizeof(sig->unit), "%d dB", sig->value);
+        s->samples[HISTORY_SIGNAL1 + i] = sig->value;
+        s->sample_seq[HISTORY_SIGNAL1 + i] = s->modem_seq;
+    }
+
+    s->samples[HISTORY_LOAD] = (int32_t)((sec * 7) % 100);
+    s->samples[HISTORY_MEMORY] = (int32_t)((412 + sec % 64) * 10000 / 1986);
+    s->samples[HISTORY_CONNTRACK] = (int32_t)(180 + (sec * 13) % 90);
+    for (int ch = HISTORY_LOAD; ch <= HISTORY_CONNTRACK; ch++)
+    {
+        s->sample_seq[ch] = s->seq;
+    }
+}
+
+static int active_screen_index(void)
+{
+    lv_obj_t *active = lv_screen_active();
+    for (int i = 0; i < BENCH_SCREEN_COUNT; i++)
+    {
+        if (*screens[i].screen == active)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: zz_xgp_screen_bench [-c cycles] [-f frames.csv]\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+    static struct metrics_snapshot snap;
+    int cycles = 1;
+    FILE *csv = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:f:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c':
+            cycles = atoi(optarg);
+            break;
+        case 'f':
+            csv = fopen(optarg, "w");
+            if (csv == NULL)
+            {
+                perror(optarg);
+                return EXIT_FAILURE;
+            }
+            fprintf(csv, "frame,time_ms,screen,render_us,flushed_px,flushes,fb_hash\n");
+            break;
+        default:
+            usage();
+        }
+    }
+    if (cycles < 1)
+    {
+        usage();
+    }
+
+    lv_init();
+    lv_tick_set_cb(bench_tick);
+    create_display();
+    ui_init();
+    ui_apply_init();
+
+    uint32_t frame_count = 0;
+    uint32_t frame_capacity = 1024;
+    uint32_t *frame_us = malloc(frame_capacity * sizeof(*frame_us));
+    uint32_t next_sample_ms = 0;
+    int last_screen = -1;
+    int cycles_done = 0;
+    uint64_t run_hash = FNV_OFFSET;
+
+    // one cycle ends when ModemSignal hands over to SystemInfo again
+    while (cycles_done < cycles && virtual_ms < BENCH_MAX_VIRTUAL_MS && frame_us != NULL)
+    {
+        if (virtual_ms >= next_sample_ms)
+        {
+            synth_snapshot(&snap, virtual_ms / 1000);
+            ui_apply_snapshot(&snap);
+            next_sample_ms += BENCH_SAMPLE_PERIOD_MS;
+        }
+
+        frame_pixels = 0;
+        frame_flushes = 0;
+        uint64_t start = monotonic_us();
+        lv_timer_handler();
+        uint32_t elapsed = (uint32_t)(monotonic_us() - start);
+
+        int screen = active_screen_index();
+        if (frame_flushes > 0 && screen >= 0)
+        {
+            struct bench_screen *s = &screens[screen];
+            s->frames++;
+            s->render_us += elapsed;
+            s->pixels += frame_pixels;
+            if (elapsed > s->max_us)
+            {
+                s->max_us = elapsed;
+            }
+            if (frame_count == frame_capacity)
+            {
+                frame_capacity *= 2;
+                frame_us = realloc(frame_us, frame_capacity * sizeof(*frame_us));
+                if (frame_us == NULL)
+                {
+                    break;
+                }
+            }
+            frame_us[frame_count++] = elapsed;
+            uint64_t fb_hash = fnv1a(FNV_OFFSET, framebuffer, sizeof(framebuffer));
+            run_hash = fnv1a(run_hash, &fb_hash, sizeof(fb_hash));
+            if (csv != NULL)
+            {
+                fprintf(csv, "%u,%u,%s,%u,%llu,%u,%016llx\n", frame_count, virtual_ms, s->name, elapsed,
+                        (unsigned long long)frame_pixels, frame_flushes, (unsigned long long)fb_hash);
+            }
+        }
+        if (screen != last_screen)
+        {
+            if (last_screen == BENCH_SCREEN_COUNT - 1 && screen >= 0 && *screens[screen].screen == ui_SystemInfo)
+            {
+                cycles_done++;
+            }
+            last_screen = screen;
+        }
+        virtual_ms += LV_DEF_REFR_PERIOD;
+    }
+    if (csv != NULL)
+    {
+        fclose(csv);
+    }
+    if (frame_us == NULL || frame_count == 0)
+    {
+        fprintf(stderr, "zz_xgp_screen_bench: no frames rendered\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-14s %7s %10s %10s %12s\n", "screen", "frames", "avg us", "max us", "avg px");
+    uint64_t total_us = 0;
+    uint64_t total_px = 0;
+    for (int i = 0; i < BENCH_SCREEN_COUNT; i++)
+    {
+        const struct bench_screen *s = &screens[i];
+        if (s->frames == 0)
+        {
+            continue;
+        }
+        printf("%-14s %7u %10llu %10llu %12llu\n", s->name, s->frames, (unsigned long long)(s->render_us / s->frames),
+               (unsigned long long)s->max_us, (unsigned long long)(s->pixels / s->frames));
+        total_us += s->render_us;
+        total_px += s->pixels;
+    }
+
+    qsort(frame_us, frame_count, sizeof(*frame_us), compare_u32);
+    printf("%u frames in %u ms virtual time: avg %llu us, p50 %u us, p95 %u us, max %u us, avg %llu px\n",
+           frame_count, virtual_ms, (unsigned long long)(total_us / frame_count), frame_us[frame_count / 2],
+           frame_us[frame_count * 95 / 100], frame_us[frame_count - 1], (unsigned long long)(total_px / frame_count));
+
+    printf("Framebuffer hash over all frames: %016llx\n", (unsigned long long)run_hash);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    printf("LVGL heap: %u of %u bytes used at the end, high-water mark %u bytes\n",
+           (unsigned)(mon.total_size - mon.free_size), (unsigned)mon.total_size, (unsigned)mon.max_used);
+    free(frame_us);
+    return EXIT_SUCCESS;
+}
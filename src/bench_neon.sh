@@ -0,0 +1,37 @@
+#!/bin/bash
+# A/B of LVGL's NEON draw kernels against the C ones on arm64.
+# Builds zz_xgp_screen_bench both ways, runs both and compares the
+# per-frame framebuffer hashes. Off the board, set RUNNER, e.g.
+#   RUNNER="qemu-aarch64 -L /usr/aarch64-linux-gnu" ./bench_neon.sh
+# (the timings are only meaningful on the device itself).
+set -e
+cd "$(dirname "$0")"
+CYCLES=${CYCLES:-1}
+
+for variant in scalar neon; do
+    if [ "$variant" = neon ]; then neon=ON; else neon=OFF; fi
+    mkdir -p build-$variant
+    (cd build-$variant &&
+     cmake -DCMAKE_TOOLCHAIN_FILE=../toolchain-arm64.cmake -DXGP_DRAW_NEON=$neon .. &&
+     make -j$(nproc) zz_xgp_screen_bench)
+    # both builds write to bin/
+    mv bin/zz_xgp_screen_bench bin/zz_xgp_screen_bench.$variant
+done
+
+if [ -z "$RUNNER" ] && [ "$(uname -m)" != aarch64 ]; then
+    echo "Built bin/zz_xgp_screen_bench.{scalar,neon}; set RUNNER to run them here"
+    exit 0
+fi
+
+for variant in scalar neon; do
+    echo "== $variant"
+    $RUNNER bin/zz_xgp_screen_bench.$variant -c "$CYCLES" -f bench-$variant.csv
+done
+
+mismatched=$(paste -d, <(cut -d, -f7 bench-scalar.csv) <(cut -d, -f7 bench-neon.csv) |
+             awk -F, 'NR > 1 && $1 != $2' | wc -l)
+if [ "$mismatched" -ne 0 ]; then
+    echo "NEON output differs from the C kernels in $mismatched frames, see bench-{scalar,neon}.csv"
+    exit 1
+fi
+echo "NEON output is pixel-identical to the C kernels"
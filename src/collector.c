@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "collector.h"
+#include "event_loop.h"
+#include "exporter.h"
+#include "ifaddr.h"
+#include "neigh.h"
+#include "providers.h"
+#include "snapshot_shm.h"
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define MAX_PROVIDERS 32
+#define SCHEDULE_IDLE_MS 60000 // re-check once a minute when nothing is due
+
+/*
+ * Three slots rotate between the collector (back), the hand-off point (ready)
+ * and the UI (front). Publishing and acquiring only exchange pointers.
+ */
+static struct metrics_snapshot snapshot_slots[3];
+static struct metrics_snapshot *snapshot_back = &snapshot_slots[0];
+static struct metrics_snapshot *snapshot_ready = &snapshot_slots[1];
+static struct metrics_snapshot *snapshot_front = &snapshot_slots[2];
+static bool snapshot_fresh = false;
+static pthread_mutex_t snapshot_lock = PTHREAD_MUTEX_INITIALIZER;
+static int publish_fd = -1;
+
+static void publish_snapshot(void)
+{
+    pthread_mutex_lock(&snapshot_lock);
+    struct metrics_snapshot *published = snapshot_back;
+    snapshot_back = snapshot_ready;
+    snapshot_ready = published;
+    snapshot_fresh = true;
+    pthread_mutex_unlock(&snapshot_lock);
+
+    snapshot_shm_publish(published);
+
+    uint64_t one = 1;
+    if (write(publish_fd, &one, sizeof(one)) < 0)
+    {
+        // counter saturated: the UI has not drained it yet, nothing to do
+    }
+
+    // carry slow-changing values (modem, static info) over into the new back slot
+    memcpy(snapshot_back, published, sizeof(*snapshot_back));
+}
+
+const struct metrics_snapshot *collector_acquire(void)
+{
+    const struct metrics_snapshot *snap = NULL;
+    uint64_t count;
+    if (read(publish_fd, &count, sizeof(count)) < 0)
+    {
+        // nothing signalled, a snapshot may still be pending
+    }
+    pthread_mutex_lock(&snapshot_lock);
+    if (snapshot_fresh)
+    {
+        struct metrics_snapshot *tmp = snapshot_front;
+        snapshot_front = snapshot_ready;
+        snapshot_ready = tmp;
+        snapshot_fresh = false;
+        snap = snapshot_front;
+    }
+    pthread_mutex_unlock(&snapshot_lock);
+    return snap;
+}
+
+static struct event_loop collector_loop;
+static uint32_t collect_seq = 0;
+
+/*
+ * Metric groups whose screen is visible or about to be, set by the UI thread.
+ * Providers of hidden groups are not run; their slots keep the last value.
+ * always_groups are run regardless: all of them while the exporter serves
+ * the snapshot, otherwise just METRIC_GROUP_ALWAYS.
+ */
+static uint32_t visible_groups = METRIC_GROUP_ALL;
+static uint32_t always_groups = METRIC_GROUP_ALWAYS; // collector thread only
+static int visible_fd = -1;
+static int schedule_timer_fd = -1;
+
+struct provider_state
+{
+    uint64_t next_due_ms; // UINT64_MAX when not scheduled
+    bool pending;         // came due while its screen was hidden
+    int event_fd;         // registered with the loop for on_event, or -1
+    int deadline_fd;      // likewise
+    uint64_t last_run_ms;
+};
+
+static struct provider_state provider_states[MAX_PROVIDERS];
+
+static uint32_t current_visible_groups(void)
+{
+    return __atomic_load_n(&visible_groups, __ATOMIC_RELAXED) | always_groups;
+}
+
+void collector_set_visible(uint32_t groups)
+{
+    __atomic_store_n(&visible_groups, groups, __ATOMIC_RELAXED);
+    uint64_t one = 1;
+    if (write(visible_fd, &one, sizeof(one)) < 0)
+    {
+        // already signalled, the collector reads the latest mask anyway
+    }
+}
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* Wakes the loop when the earliest provider is due */
+static void arm_schedule_timer(void)
+{
+    uint64_t next_due = UINT64_MAX;
+    for (size_t i = 0; i < metric_provider_count; i++)
+    {
+        if (provider_states[i].next_due_ms < next_due)
+        {
+            next_due = provider_states[i].next_due_ms;
+        }
+    }
+    uint64_t now = monotonic_ms();
+    uint64_t delay = next_due <= now ? 0 : next_due - now;
+    event_loop_set_timer(schedule_timer_fd, delay > SCHEDULE_IDLE_MS ? SCHEDULE_IDLE_MS : (uint32_t)delay, 0);
+}
+
+static void on_provider_event(int fd, uint32_t events, void *arg);
+
+/* (Re-)registers the provider's reply and deadline fds; the reply fd may be a new pipe on the same number */
+static void watch_provider_fd(size_t i)
+{
+    const struct metric_provider *p = &metric_providers[i];
+    struct provider_state *st = &provider_states[i];
+
+    if (p->deadline_fd != NULL && p->deadline_fd() != st->deadline_fd)
+    {
+        // created with the first request, then kept
+        if (st->deadline_fd >= 0)
+        {
+            event_loop_del(&collector_loop, st->deadline_fd);
+        }
+        st->deadline_fd = p->deadline_fd();
+        if (st->deadline_fd >= 0)
+        {
+            event_loop_add(&collector_loop, st->deadline_fd, EPOLLIN, on_provider_event, (void *)(uintptr_t)i);
+        }
+    }
+    if (p->event_fd == NULL)
+    {
+        return;
+    }
+    if (st->event_fd >= 0)
+    {
+        event_loop_del(&collector_loop, st->event_fd);
+    }
+    st->event_fd = p->event_fd();
+    if (st->event_fd >= 0)
+    {
+        event_loop_add(&collector_loop, st->event_fd, EPOLLIN, on_provider_event, (void *)(uintptr_t)i);
+    }
+}
+
+static void on_provider_event(int fd, uint32_t events, void *arg)
+{
+    (void)fd;
+    (void)events;
+    size_t i = (uintptr_t)arg;
+    const struct metric_provider *p = &metric_providers[i];
+
+    if (p->on_event(snapshot_back))
+    {
+        snapshot_back->seq = ++collect_seq;
+        publish_snapshot();
+
+        // the reply may have changed the rate, reschedule from when it was asked for
+        struct provider_state *st = &provider_states[i];
+        if (p->next_period != NULL && st->next_due_ms != UINT64_MAX)
+        {
+            st->next_due_ms = st->last_run_ms + p->next_period();
+            arm_schedule_timer();
+        }
+    }
+    // the reply or the deadline may have closed the reply fd
+    if (p->event_fd() != provider_states[i].event_fd)
+    {
+        watch_provider_fd(i);
+    }
+}
+
+static void run_provider(size_t i, uint64_t now)
+{
+    const struct metric_provider *p = &metric_providers[i];
+    char *slot = p->slot == METRIC_NO_SLOT ? NULL : (char *)snapshot_back + p->slot;
+
+    p->update(snapshot_back, slot);
+    watch_provider_fd(i);
+    provider_states[i].pending = false;
+    provider_states[i].last_run_ms = now;
+    if (p->period_ms == METRIC_ONCE)
+    {
+        provider_states[i].next_due_ms = UINT64_MAX;
+    }
+    else
+    {
+        provider_states[i].next_due_ms = now + (p->next_period != NULL ? p->next_period() : p->period_ms);
+    }
+}
+
+/*
+ * Runs every provider that is due, plus those selected by the refresh
+ * groups/triggers, cheapest first. Values are published before a subprocess
+ * runs so they are not held back by it.
+ */
+static void run_providers(uint32_t refresh_groups, uint32_t triggers)
+{
+    uint32_t visible = current_visible_groups();
+    uint64_t now = monotonic_ms();
+    bool changed = false;
+
+    for (int cost = METRIC_COST_CACHED; cost <= METRIC_COST_SUBPROCESS; cost++)
+    {
+        for (size_t i = 0; i < metric_provider_count; i++)
+        {
+            const struct metric_provider *p = &metric_providers[i];
+            struct provider_state *st = &provider_states[i];
+            if ((int)p->cost != cost)
+            {
+                continue;
+            }
+
+            bool due = st->next_due_ms <= now;
+            bool run;
+            if (p->period_ms == METRIC_ONCE)
+            {
+                run = due; // static values are cheap enough to read while hidden
+            }
+            else if (!(p->group & visible))
+            {
+                if (due)
+                {
+                    st->pending = true;
+                    st->next_due_ms = UINT64_MAX;
+                }
+                run = false;
+            }
+            else if (p->group & refresh_groups)
+            {
+                // a slow provider is only worth re-running if it missed its period
+                run = due || st->pending || p->cost != METRIC_COST_SUBPROCESS;
+            }
+            else
+            {
+                run = due || (p->triggers & triggers) || st->pending;
+            }
+            if (!run)
+            {
+                continue;
+            }
+
+            if (p->cost == METRIC_COST_SUBPROCESS && changed)
+            {
+                snapshot_back->seq = ++collect_seq;
+                publish_snapshot();
+                changed = false;
+            }
+            run_provider(i, now);
+            changed = true;
+            if (p->cost == METRIC_COST_SUBPROCESS)
+            {
+                now = monotonic_ms();
+            }
+        }
+    }
+
+    if (changed)
+    {
+        snapshot_back->seq = ++collect_seq;
+        publish_snapshot();
+    }
+
+    arm_schedule_timer();
+}
+
+static void on_schedule_timer(int fd, uint32_t events, void *arg)
+{
+    (void)fd;
+    (void)events;
+    (void)arg;
+    run_providers(0, 0);
+}
+
+static uint32_t collected_groups = METRIC_GROUP_ALL;
+
+static void on_visible_changed(int fd, uint32_t events, void *arg)
+{
+    (void)events;
+    (void)arg;
+    uint64_t count;
+    if (read(fd, &count, sizeof(count)) < 0)
+    {
+        return;
+    }
+
+    // fill in newly shown screens now rather than at their next period
+    uint32_t groups = current_visible_groups();
+    uint32_t added = groups & ~collected_groups;
+    collected_groups = groups;
+    run_providers(added, 0);
+}
+
+static void on_ifaddr_event(int fd, uint32_t events, void *arg)
+{
+    (void)fd;
+    (void)events;
+    (void)arg;
+    // address change: publish right away instead of at the next period
+    if (ifaddr_poll())
+    {
+        run_providers(0, METRIC_TRIGGER_IFADDR);
+    }
+}
+
+static void on_neigh_event(int fd, uint32_t events, void *arg)
+{
+    (void)fd;
+    (void)events;
+    (void)arg;
+    neigh_poll();
+}
+
+static void *collector_thread(void *arg)
+{
+    (void)arg;
+
+    metric_providers_init();
+    snapshot_shm_init();
+    neigh_init();
+    ifaddr_init();
+
+    uint64_t now = monotonic_ms();
+    for (size_t i = 0; i < metric_provider_count; i++)
+    {
+        provider_states[i].next_due_ms = now + metric_providers[i].initial_delay_ms;
+        provider_states[i].event_fd = -1;
+        provider_states[i].deadline_fd = -1;
+    }
+
+    event_loop_add(&collector_loop, ifaddr_fd(), EPOLLIN, on_ifaddr_event, NULL);
+    event_loop_add(&collector_loop, neigh_fd(), EPOLLIN, on_neigh_event, NULL);
+    event_loop_add(&collector_loop, visible_fd, EPOLLIN, on_visible_changed, NULL);
+    schedule_timer_fd = event_loop_add_timer(&collector_loop, 0, 0, on_schedule_timer, NULL);
+    // between handlers the back slot holds exactly what was published last
+    if (exporter_start(&collector_loop, &snapshot_back) > 0)
+    {
+        always_groups = METRIC_GROUP_ALL;
+    }
+
+    while (1)
+    {
+        event_loop_run_once(&collector_loop, -1);
+    }
+
+    return NULL;
+}
+
+int collector_fd(void)
+{
+    return publish_fd;
+}
+
+int collector_start(void)
+{
+    pthread_t thread;
+
+    publish_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    visible_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (metric_provider_count > MAX_PROVIDERS)
+    {
+        fprintf(stderr, "Error: too many metric providers\n");
+        return -1;
+    }
+    if (publish_fd < 0 || visible_fd < 0 || event_loop_init(&collector_loop) != 0)
+    {
+        perror("collector init");
+        return -1;
+    }
+
+    int ret = pthread_create(&thread, NULL, collector_thread, NULL);
+    if (ret != 0)
+    {
+        fprintf(stderr, "Error: failed to start collector thread: %s\n", strerror(ret));
+        return -1;
+    }
+    pthread_detach(thread);
+    return 0;
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_COLLECTOR_H
+#define _XGP_V3_COLLECTOR_H
+
+#include "metrics.h"
+
+/*
+ * Background metric collection.
+ *
+ * The collector thread owns all /proc, socket and modem I/O. Every finished
+ * cycle is published by swapping buffer pointers under a short mutex, so the
+ * UI thread never waits for a slow read.
+ */
+
+int collector_start(void);
+
+/*
+ * Restricts collection to the given groups (everything until first called).
+ * Groups that were not collected before are refreshed immediately.
+ */
+void collector_set_visible(uint32_t groups);
+
+/* eventfd that becomes readable whenever a new snapshot is published */
+int collector_fd(void);
+
+/*
+ * Returns the newest snapshot if one was published since the last call,
+ * NULL otherwise. The returned pointer stays valid and unchanged until the
+ * next call; only the UI thread may call this.
+ */
+const struct metrics_snapshot *collector_acquire(void);
+
+#endif
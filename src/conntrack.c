@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "conntrack.h"
+#include "netlink.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <linux/netfilter/nfnetlink.h>
+#include <linux/netfilter/nfnetlink_conntrack.h>
+
+#define NF_CONNTRACK_COUNT_PATH "/proc/sys/net/netfilter/nf_conntrack_count"
+
+enum conntrack_source
+{
+    CONNTRACK_SOURCE_NONE = 0,
+    CONNTRACK_SOURCE_PROC,
+    CONNTRACK_SOURCE_NETLINK,
+    CONNTRACK_SOURCE_UNAVAILABLE,
+};
+
+static enum conntrack_source source = CONNTRACK_SOURCE_NONE;
+static int count_fd = -1;
+static struct nl_sock ctnl = {.fd = -1};
+
+static int read_proc_count(void)
+{
+    char buf[24];
+    ssize_t len = pread(count_fd, buf, sizeof(buf) - 1, 0);
+    if (len <= 0)
+    {
+        return -1;
+    }
+
+    int count = 0;
+    for (ssize_t i = 0; i < len && buf[i] >= '0' && buf[i] <= '9'; i++)
+    {
+        count = count * 10 + (buf[i] - '0');
+    }
+    return count;
+}
+
+static void handle_stats_reply(const struct nlmsghdr *nlh, void *arg)
+{
+    int *count = arg;
+    const struct nlattr *tb[CTA_STATS_GLOBAL_MAX + 1];
+    int hdrlen = NLMSG_SPACE(sizeof(struct nfgenmsg));
+
+    if (NFNL_SUBSYS_ID(nlh->nlmsg_type) != NFNL_SUBSYS_CTNETLINK || (int)nlh->nlmsg_len < hdrlen)
+    {
+        return;
+    }
+    nl_parse_attrs((const char *)nlh + hdrlen, nlh->nlmsg_len - hdrlen, tb, CTA_STATS_GLOBAL_MAX);
+    if (tb[CTA_STATS_GLOBAL_ENTRIES] != NULL && nl_attr_len(tb[CTA_STATS_GLOBAL_ENTRIES]) >= 4)
+    {
+        uint32_t entries;
+        memcpy(&entries, nl_attr_data(tb[CTA_STATS_GLOBAL_ENTRIES]), sizeof(entries));
+        *count = (int)ntohl(entries);
+    }
+}
+
+static int query_netlink_count(void)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct nfgenmsg nfg;
+    } req;
+    int count = -1;
+
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(req.nfg));
+    req.nlh.nlmsg_type = (NFNL_SUBSYS_CTNETLINK << 8) | IPCTNL_MSG_CT_GET_STATS;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST;
+    req.nfg.nfgen_family = AF_UNSPEC;
+    req.nfg.version = NFNETLINK_V0;
+
+    int seq = nl_send(&ctnl, &req.nlh);
+    if (seq < 0 || nl_recv_reply(&ctnl, (uint32_t)seq, handle_stats_reply, &count) < 0)
+    {
+        return -1;
+    }
+    return count;
+}
+
+static void select_source(void)
+{
+    count_fd = open(NF_CONNTRACK_COUNT_PATH, O_RDONLY | O_CLOEXEC);
+    if (count_fd >= 0)
+    {
+        source = CONNTRACK_SOURCE_PROC;
+        return;
+    }
+
+    if (nl_open(&ctnl, NETLINK_NETFILTER, 0) == 0 && query_netlink_count() >= 0)
+    {
+        source = CONNTRACK_SOURCE_NETLINK;
+        return;
+    }
+
+    nl_close(&ctnl);
+    fprintf(stderr, "Warning: conntrack count unavailable (no %s, no ctnetlink)\n", NF_CONNTRACK_COUNT_PATH);
+    source = CONNTRACK_SOURCE_UNAVAILABLE;
+}
+
+int conntrack_count(void)
+{
+    if (source == CONNTRACK_SOURCE_NONE)
+    {
+        select_source();
+    }
+
+    switch (source)
+    {
+    case CONNTRACK_SOURCE_PROC:
+        return read_proc_count();
+    case CONNTRACK_SOURCE_NETLINK:
+        return query_netlink_count();
+    default:
+        return -1;
+    }
+}
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_CONNTRACK_H
+#define _XGP_V3_CONNTRACK_H
+
+/*
+ * Number of tracked connections, read from nf_conntrack_count through a
+ * kept-open fd. Falls back to a ctnetlink IPCTNL_MSG_CT_GET_STATS query when
+ * the sysctl is not available. Returns -1 if neither source works.
+ */
+int conntrack_count(void);
+
+#endif
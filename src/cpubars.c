@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "cpubars.h"
+#include "lvgl/lvgl.h"
+#include "ui/ui.h"
+#include "ui_bind.h"
+
+#define CPUBAR_WIDTH 6
+#define CPUBAR_HEIGHT 22
+#define CPUBAR_GAP 2
+
+static lv_obj_t *busy_bars[CPU_CORE_SLOTS];
+static lv_obj_t *softirq_bars[CPU_CORE_SLOTS];
+static struct bar_binding busy_bindings[CPU_CORE_SLOTS];
+static struct bar_binding softirq_bindings[CPU_CORE_SLOTS];
+static int bar_count = 0;
+
+static lv_obj_t *create_bar(lv_obj_t *anchor, lv_color_t color)
+{
+    lv_obj_t *bar = lv_bar_create(lv_obj_get_parent(anchor));
+    lv_obj_set_size(bar, CPUBAR_WIDTH, CPUBAR_HEIGHT); // taller than wide: fills bottom-up
+    lv_obj_remove_flag(bar, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_radius(bar, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_radius(bar, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(bar, color, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    return bar;
+}
+
+static void create_bars(int count)
+{
+    lv_obj_t *anchor = ui_valLoadAvg;
+
+    lv_obj_update_layout(anchor);
+    for (int i = bar_count; i < count; i++)
+    {
+        busy_bars[i] = create_bar(anchor, lv_palette_main(LV_PALETTE_BLUE));
+        lv_obj_set_style_bg_color(busy_bars[i], lv_palette_lighten(LV_PALETTE_GREY, 3),
+                                  LV_PART_MAIN | LV_STATE_DEFAULT);
+        // drawn over the busy bar, only its indicator is visible
+        softirq_bars[i] = create_bar(anchor, lv_palette_main(LV_PALETTE_ORANGE));
+        lv_obj_set_style_bg_opa(softirq_bars[i], LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+        busy_bindings[i] = (struct bar_binding)BAR_BINDING_INIT(busy_bars[i]);
+        softirq_bindings[i] = (struct bar_binding)BAR_BINDING_INIT(softirq_bars[i]);
+    }
+    bar_count = count;
+
+    // right-aligned to the label, so more cores grow to the left
+    for (int i = 0; i < bar_count; i++)
+    {
+        int32_t x = -(bar_count - 1 - i) * (CPUBAR_WIDTH + CPUBAR_GAP);
+        lv_obj_align_to(busy_bars[i], anchor, LV_ALIGN_RIGHT_MID, x, 0);
+        lv_obj_align_to(softirq_bars[i], anchor, LV_ALIGN_RIGHT_MID, x, 0);
+    }
+}
+
+void cpubars_update(const struct cpu_core_usage *cores, int count)
+{
+    if (ui_valLoadAvg == NULL || count <= 0)
+    {
+        return;
+    }
+    if (count > bar_count)
+    {
+        create_bars(count);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        ui_bind_bar(&busy_bindings[i], 0, 100, cores[i].busy);
+        ui_bind_bar(&softirq_bindings[i], 0, 100, cores[i].softirq);
+    }
+}
@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_CPUBARS_H
+#define _XGP_V3_CPUBARS_H
+
+#include "metrics.h"
+
+/*
+ * One small vertical bar per core at the right end of the load average:
+ * the bar is the busy share, the orange part at its foot the softirq share.
+ * The bars are created on the first update that knows the core count.
+ */
+void cpubars_update(const struct cpu_core_usage *cores, int count);
+
+#endif
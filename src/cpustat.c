@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "cpustat.h"
+#include "procfs.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// columns of a cpuN line; guest time is already included in user/nice
+enum cpu_field
+{
+    CPU_USER,
+    CPU_NICE,
+    CPU_SYSTEM,
+    CPU_IDLE,
+    CPU_IOWAIT,
+    CPU_IRQ,
+    CPU_SOFTIRQ,
+    CPU_STEAL,
+    CPU_FIELDS,
+};
+
+struct cpu_times
+{
+    bool valid;
+    uint64_t total;
+    uint64_t idle;
+    uint64_t softirq;
+};
+
+static struct procfs_file stat_file = PROCFS_FILE_INIT("/proc/stat");
+static struct cpu_times last_times[CPU_CORE_SLOTS];
+static uint64_t last_sample_ms = 0;
+
+/* Parses "cpuN  user nice ...", returns N or -1 for the aggregate line */
+static int parse_cpu_line(const char *line, struct cpu_times *t)
+{
+    uint64_t index;
+    uint64_t v[CPU_FIELDS] = {0};
+
+    if (line[3] < '0' || line[3] > '9')
+    {
+        return -1;
+    }
+    const char *p = procfs_parse_u64(line + 3, &index);
+    // older kernels print fewer columns, the missing ones stay 0
+    for (int i = 0; i < CPU_FIELDS && p != NULL; i++)
+    {
+        p = procfs_parse_u64(p, &v[i]);
+    }
+
+    t->total = 0;
+    for (int i = 0; i < CPU_FIELDS; i++)
+    {
+        t->total += v[i];
+    }
+    t->idle = v[CPU_IDLE] + v[CPU_IOWAIT];
+    t->softirq = v[CPU_SOFTIRQ];
+    t->valid = true;
+    return index < CPU_CORE_SLOTS ? (int)index : -1;
+}
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static uint8_t percent(uint64_t part, uint64_t whole)
+{
+    if (whole == 0 || part > whole)
+    {
+        return 0;
+    }
+    return (uint8_t)((part * 100 + whole / 2) / whole);
+}
+
+int cpustat_sample(struct cpu_core_usage *cores, int max)
+{
+    struct cpu_times now[CPU_CORE_SLOTS];
+    int count = 0;
+
+    if (procfs_read(&stat_file) <= 0)
+    {
+        return -1;
+    }
+
+    memset(now, 0, sizeof(now));
+    const char *line = procfs_find_line(stat_file.buf, "cpu");
+    while (line != NULL && strncmp(line, "cpu", 3) == 0)
+    {
+        struct cpu_times t;
+        int index = parse_cpu_line(line, &t);
+        if (index >= 0)
+        {
+            now[index] = t;
+            if (index >= count)
+            {
+                count = index + 1;
+            }
+        }
+        line = strchr(line, '\n');
+        if (line != NULL)
+        {
+            line++;
+        }
+    }
+    if (count == 0)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < count && i < max; i++)
+    {
+        const struct cpu_times *prev = &last_times[i];
+        const struct cpu_times *cur = &now[i];
+
+        memset(&cores[i], 0, sizeof(cores[i]));
+        // offline cores have no line; counters restart when one comes back
+        if (!prev->valid || !cur->valid || cur->total < prev->total || cur->idle < prev->idle ||
+            cur->softirq < prev->softirq)
+        {
+            continue;
+        }
+        uint64_t total = cur->total - prev->total;
+        cores[i].busy = percent(total - (cur->idle - prev->idle), total);
+        cores[i].softirq = percent(cur->softirq - prev->softirq, total);
+    }
+    memcpy(last_times, now, sizeof(last_times));
+
+    // the first call, or the first after the screen was hidden: the delta
+    // would average over the whole gap, only keep it as the next baseline
+    uint64_t now_ms = monotonic_ms();
+    bool stale = last_sample_ms == 0 || now_ms - last_sample_ms > CPUSTAT_MAX_GAP_MS;
+    last_sample_ms = now_ms;
+    if (stale)
+    {
+        return -1;
+    }
+    return count < max ? count : max;
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_CPUSTAT_H
+#define _XGP_V3_CPUSTAT_H
+
+#include "metrics.h"
+
+#define CPUSTAT_MAX_GAP_MS 2500 // about two periods of the 1 s cpu_usage provider
+
+/*
+ * Per-core utilisation from the cpuN lines of /proc/stat. The file is kept
+ * open and re-read with procfs_read(); usage is the jiffy delta against
+ * the previous call.
+ *
+ * Fills up to max cores and returns how many there are (highest cpuN + 1),
+ * or -1 when /proc/stat cannot be read, on the first call and when the
+ * previous call is more than CPUSTAT_MAX_GAP_MS ago, e.g. while the screen
+ * was hidden, as that delta would not be "the last second".
+ */
+int cpustat_sample(struct cpu_core_usage *cores, int max);
+
+#endif
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "event_loop.h"
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+int event_loop_init(struct event_loop *loop)
+{
+    memset(loop, 0, sizeof(*loop));
+    for (int i = 0; i < EVENT_LOOP_MAX_HANDLERS; i++)
+    {
+        loop->handlers[i].fd = -1;
+    }
+    loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epfd < 0)
+    {
+        perror("epoll_create1");
+        return -1;
+    }
+    return 0;
+}
+
+static struct event_handler *add_handler(struct event_loop *loop, int fd, uint32_t events, event_cb cb, void *arg)
+{
+    struct event_handler *h = NULL;
+    struct epoll_event ev;
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < EVENT_LOOP_MAX_HANDLERS; i++)
+    {
+        if (loop->handlers[i].fd < 0)
+        {
+            h = &loop->handlers[i];
+            break;
+        }
+    }
+    if (h == NULL)
+    {
+        fprintf(stderr, "Error: event loop handler table full\n");
+        return NULL;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = h;
+    if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        perror("epoll_ctl");
+        return NULL;
+    }
+    h->fd = fd;
+    h->is_timer = 0;
+    h->cb = cb;
+    h->arg = arg;
+    return h;
+}
+
+int event_loop_add(struct event_loop *loop, int fd, uint32_t events, event_cb cb, void *arg)
+{
+    return add_handler(loop, fd, events, cb, arg) != NULL ? 0 : -1;
+}
+
+void event_loop_del(struct event_loop *loop, int fd)
+{
+    for (int i = 0; i < EVENT_LOOP_MAX_HANDLERS; i++)
+    {
+        if (loop->handlers[i].fd == fd)
+        {
+            epoll_ctl(loop->epfd, EPOLL_CTL_DEL, fd, NULL);
+            loop->handlers[i].fd = -1;
+            return;
+        }
+    }
+}
+
+int event_loop_set_timer(int timer_fd, uint32_t initial_ms, uint32_t period_ms)
+{
+    struct itimerspec its;
+
+    // an all-zero it_value would disarm the timer
+    if (initial_ms == 0)
+    {
+        initial_ms = 1;
+    }
+    its.it_value.tv_sec = initial_ms / 1000;
+    its.it_value.tv_nsec = (long)(initial_ms % 1000) * 1000000L;
+    its.it_interval.tv_sec = period_ms / 1000;
+    its.it_interval.tv_nsec = (long)(period_ms % 1000) * 1000000L;
+    return timerfd_settime(timer_fd, 0, &its, NULL);
+}
+
+int event_loop_create_timer(void)
+{
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+    {
+        perror("timerfd_create");
+    }
+    return fd;
+}
+
+int event_loop_stop_timer(int timer_fd)
+{
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    return timerfd_settime(timer_fd, 0, &its, NULL);
+}
+
+int event_loop_timer_fired(int timer_fd)
+{
+    uint64_t expirations;
+    return timer_fd >= 0 && read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations);
+}
+
+int event_loop_add_timer(struct event_loop *loop, uint32_t initial_ms, uint32_t period_ms, event_cb cb, void *arg)
+{
+    int fd = event_loop_create_timer();
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct event_handler *h = add_handler(loop, fd, EPOLLIN, cb, arg);
+    if (h == NULL || event_loop_set_timer(fd, initial_ms, period_ms) < 0)
+    {
+        if (h != NULL)
+        {
+            event_loop_del(loop, fd);
+        }
+        close(fd);
+        return -1;
+    }
+    h->is_timer = 1;
+    return fd;
+}
+
+int event_loop_run_once(struct event_loop *loop, int timeout_ms)
+{
+    struct epoll_event events[EVENT_LOOP_MAX_HANDLERS];
+
+    int n = epoll_wait(loop->epfd, events, EVENT_LOOP_MAX_HANDLERS, timeout_ms);
+    if (n < 0)
+    {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        struct event_handler *h = events[i].data.ptr;
+        if (h->fd < 0)
+        {
+            continue; // removed by an earlier handler in this batch
+        }
+        if (h->is_timer)
+        {
+            uint64_t expirations;
+            if (read(h->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+            {
+                continue;
+            }
+        }
+        h->cb(h->fd, events[i].events, h->arg);
+    }
+    return n;
+}
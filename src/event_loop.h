@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_EVENT_LOOP_H
+#define _XGP_V3_EVENT_LOOP_H
+
+#include <stdint.h>
+
+/*
+ * Small epoll wrapper. Each thread that waits on fds owns one loop; periodic
+ * work is driven by timerfds so periods do not drift with handler cost.
+ */
+
+#define EVENT_LOOP_MAX_HANDLERS 16
+
+typedef void (*event_cb)(int fd, uint32_t events, void *arg);
+
+struct event_handler
+{
+    int fd;
+    int is_timer;
+    event_cb cb;
+    void *arg;
+};
+
+struct event_loop
+{
+    int epfd;
+    struct event_handler handlers[EVENT_LOOP_MAX_HANDLERS];
+};
+
+int event_loop_init(struct event_loop *loop);
+int event_loop_add(struct event_loop *loop, int fd, uint32_t events, event_cb cb, void *arg);
+void event_loop_del(struct event_loop *loop, int fd);
+
+/*
+ * Creates a CLOCK_MONOTONIC timerfd firing first after initial_ms, then every
+ * period_ms (0 for one-shot). The loop consumes the expiration count before
+ * calling cb. Returns the timerfd or -1.
+ */
+int event_loop_add_timer(struct event_loop *loop, uint32_t initial_ms, uint32_t period_ms, event_cb cb, void *arg);
+int event_loop_set_timer(int timer_fd, uint32_t initial_ms, uint32_t period_ms);
+
+/*
+ * Deadlines: a disarmed timerfd that is armed and stopped as requests come
+ * and go. Whoever registers it with event_loop_add() consumes the expiration
+ * with event_loop_timer_fired(), which returns 1 if it has fired.
+ */
+int event_loop_create_timer(void);
+int event_loop_stop_timer(int timer_fd);
+int event_loop_timer_fired(int timer_fd);
+
+/* Waits up to timeout_ms (-1 forever) and dispatches ready handlers */
+int event_loop_run_once(struct event_loop *loop, int timeout_ms);
+
+#endif
@@ -0,0 +1,456 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "exporter.h"
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define EXPORTER_REQUEST_SIZE 1024
+#define EXPORTER_RESPONSE_SIZE 16384
+
+struct exporter_client
+{
+    int fd; // -1 when the slot is free
+    uint32_t accepted; // accept order, the oldest client is dropped when full
+    size_t req_len;
+    char req[EXPORTER_REQUEST_SIZE];
+    size_t resp_len;
+    size_t resp_sent;
+    char resp[EXPORTER_RESPONSE_SIZE];
+};
+
+static struct event_loop *exporter_loop;
+static struct metrics_snapshot *const *exporter_snapshot;
+static struct exporter_client clients[EXPORTER_MAX_CLIENTS];
+static uint32_t accept_count = 0;
+
+struct text_buf
+{
+    char *p;
+    size_t len;
+    size_t cap;
+};
+
+static void tb_printf(struct text_buf *tb, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void tb_printf(struct text_buf *tb, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(tb->p + tb->len, tb->cap - tb->len, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+    {
+        // on overflow the response is cut short, the scraper sees a parse error
+        tb->len += (size_t)n < tb->cap - tb->len ? (size_t)n : tb->cap - tb->len - 1;
+    }
+}
+
+/* Label values escape backslash, double quote and newline */
+static void tb_label(struct text_buf *tb, const char *name, const char *value, bool first)
+{
+    tb_printf(tb, "%s%s=\"", first ? "" : ",", name);
+    for (const char *c = value; *c != '\0' && tb->len + 3 < tb->cap; c++)
+    {
+        if (*c == '\\' || *c == '"')
+        {
+            tb->p[tb->len++] = '\\';
+            tb->p[tb->len++] = *c;
+        }
+        else if (*c == '\n')
+        {
+            tb->p[tb->len++] = '\\';
+            tb->p[tb->len++] = 'n';
+        }
+        else
+        {
+            tb->p[tb->len++] = *c;
+        }
+    }
+    tb->p[tb->len] = '\0';
+    tb_printf(tb, "\"");
+}
+
+static void tb_header(struct text_buf *tb, const char *name, const char *help)
+{
+    tb_printf(tb, "# HELP %s %s\n# TYPE %s gauge\n", name, help, name);
+}
+
+static void render_ipv4(struct text_buf *tb, const char *link, const char *address)
+{
+    if (address[0] == '\0' || strcmp(address, UNKNOWN_IP_REPLACE_STRING) == 0)
+    {
+        return;
+    }
+    tb_printf(tb, "xgp_interface_ipv4_info{");
+    tb_label(tb, "link", link, true);
+    tb_label(tb, "address", address, false);
+    tb_printf(tb, "} 1\n");
+}
+
+static void render_modem(struct text_buf *tb, const struct modem_metrics *m)
+{
+    tb_header(tb, "xgp_modem_info", "Modem identity and registration, as shown on the ModemInfo screen.");
+    tb_printf(tb, "xgp_modem_info{");
+    tb_label(tb, "revision", m->revision, true);
+    tb_label(tb, "connect", m->connect, false);
+    tb_label(tb, "sim", m->sim, false);
+    tb_label(tb, "isp", m->isp, false);
+    tb_label(tb, "network_mode", m->networkmode, false);
+    tb_label(tb, "cqi", m->cqi, false);
+    tb_label(tb, "ambr", m->ambr, false);
+    tb_printf(tb, "} 1\n");
+
+    // the modem reports e.g. "45 ℃"; skip it if there is no leading number
+    char *end;
+    double temperature = strtod(m->temperature, &end);
+    if (end != m->temperature)
+    {
+        tb_header(tb, "xgp_modem_temperature_celsius", "Modem temperature.");
+        tb_printf(tb, "xgp_modem_temperature_celsius %g\n", temperature);
+    }
+
+    tb_header(tb, "xgp_modem_signal", "Modem signal channels in their own unit, with the bar range as min/max.");
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        const struct modem_signal *sig = &m->signal[i];
+        if (sig->name[0] == '\0' || strcmp(sig->name, UNKNOWN_VALUE_REPLACE_STRING) == 0)
+        {
+            continue;
+        }
+        static const char *const bounds[] = {"value", "min", "max"};
+        const int values[] = {sig->value, sig->min, sig->max};
+        for (int b = 0; b < 3; b++)
+        {
+            tb_printf(tb, "xgp_modem_signal{");
+            tb_label(tb, "name", sig->name, true);
+            tb_label(tb, "bound", bounds[b], false);
+            tb_printf(tb, "} %d\n", values[b]);
+        }
+    }
+}
+
+static size_t render_metrics(const struct metrics_snapshot *s, char *buf, size_t size)
+{
+    struct text_buf tb = {.p = buf, .len = 0, .cap = size};
+
+    tb_printf(&tb, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n");
+
+    tb_header(&tb, "xgp_snapshot_seq", "Collection cycles published so far.");
+    tb_printf(&tb, "xgp_snapshot_seq %u\n", s->seq);
+
+    tb_header(&tb, "xgp_info", "Static system information.");
+    tb_printf(&tb, "xgp_info{");
+    tb_label(&tb, "hostname", s->hostname, true);
+    tb_label(&tb, "version", s->sys_version, false);
+    tb_label(&tb, "build_id", s->build_id, false);
+    tb_label(&tb, "kernel", s->kernel_version, false);
+    tb_printf(&tb, "} 1\n");
+
+    if (s->sample_seq[HISTORY_LOAD] != 0)
+    {
+        tb_header(&tb, "xgp_load1", "1 minute load average.");
+        tb_printf(&tb, "xgp_load1 %d.%02d\n", s->samples[HISTORY_LOAD] / 100, s->samples[HISTORY_LOAD] % 100);
+    }
+    if (s->sample_seq[HISTORY_MEMORY] != 0)
+    {
+        tb_header(&tb, "xgp_memory_used_ratio", "Used share of physical memory.");
+        tb_printf(&tb, "xgp_memory_used_ratio %d.%04d\n", s->samples[HISTORY_MEMORY] / 10000,
+                  s->samples[HISTORY_MEMORY] % 10000);
+    }
+    if (s->sample_seq[HISTORY_CONNTRACK] != 0)
+    {
+        tb_header(&tb, "xgp_conntrack_entries", "Tracked connections.");
+        tb_printf(&tb, "xgp_conntrack_entries %d\n", s->samples[HISTORY_CONNTRACK]);
+    }
+
+    if (s->cpu_count > 0)
+    {
+        tb_header(&tb, "xgp_cpu_busy_percent", "Share of the last second each core was busy.");
+        for (int i = 0; i < s->cpu_count; i++)
+        {
+            tb_printf(&tb, "xgp_cpu_busy_percent{cpu=\"%d\"} %u\n", i, s->cpu[i].busy);
+        }
+        tb_header(&tb, "xgp_cpu_softirq_percent", "Share of the last second each core spent in softirq.");
+        for (int i = 0; i < s->cpu_count; i++)
+        {
+            tb_printf(&tb, "xgp_cpu_softirq_percent{cpu=\"%d\"} %u\n", i, s->cpu[i].softirq);
+        }
+    }
+
+    if (s->soc_temp_mc != INT32_MIN)
+    {
+        tb_header(&tb, "xgp_soc_temperature_celsius", "Hottest thermal zone.");
+        tb_printf(&tb, "xgp_soc_temperature_celsius %.3f\n", s->soc_temp_mc / 1000.0);
+        tb_header(&tb, "xgp_soc_overheat", "1 while a thermal zone is over its warning threshold.");
+        tb_printf(&tb, "xgp_soc_overheat %d\n", s->overheat ? 1 : 0);
+    }
+
+    tb_header(&tb, "xgp_interface_ipv4_info", "Primary IPv4 address of the modem, WAN and LAN links.");
+    render_ipv4(&tb, "modem", s->modem_ip);
+    render_ipv4(&tb, "wan", s->wan_ip);
+    render_ipv4(&tb, "lan", s->lan_ip);
+
+    tb_header(&tb, "xgp_neighbours_online", "Reachable neighbours per interface.");
+    for (int i = 0; i < s->arp_iface_count; i++)
+    {
+        tb_printf(&tb, "xgp_neighbours_online{");
+        tb_label(&tb, "iface", s->arp_ifaces[i].name, true);
+        tb_printf(&tb, "} %d\n", s->arp_ifaces[i].online);
+    }
+
+    if (s->modem_seq != 0)
+    {
+        render_modem(&tb, &s->modem);
+    }
+    return tb.len;
+}
+
+static size_t render_error(const char *status, char *buf, size_t size)
+{
+    int n = snprintf(buf, size, "HTTP/1.0 %s\r\nContent-Type: text/plain\r\nConnection: close\r\n\r\n%s\n",
+                     status, status);
+    return n > 0 && (size_t)n < size ? (size_t)n : 0;
+}
+
+static void close_client(struct exporter_client *c)
+{
+    event_loop_del(exporter_loop, c->fd);
+    close(c->fd);
+    c->fd = -1;
+}
+
+static void on_client_event(int fd, uint32_t events, void *arg);
+
+/* Sends what the socket takes; waits for EPOLLOUT for the rest */
+static void flush_client(struct exporter_client *c)
+{
+    while (c->resp_sent < c->resp_len)
+    {
+        ssize_t n = send(c->fd, c->resp + c->resp_sent, c->resp_len - c->resp_sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            event_loop_del(exporter_loop, c->fd);
+            event_loop_add(exporter_loop, c->fd, EPOLLOUT, on_client_event, c);
+            return;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        c->resp_sent += (size_t)n;
+    }
+    close_client(c);
+}
+
+static void handle_request(struct exporter_client *c)
+{
+    if (strncmp(c->req, "GET ", 4) != 0)
+    {
+        c->resp_len = render_error("405 Method Not Allowed", c->resp, sizeof(c->resp));
+    }
+    else if (strncmp(c->req + 4, "/metrics ", 9) == 0 || strncmp(c->req + 4, "/ ", 2) == 0)
+    {
+        c->resp_len = render_metrics(*exporter_snapshot, c->resp, sizeof(c->resp));
+    }
+    else
+    {
+        c->resp_len = render_error("404 Not Found", c->resp, sizeof(c->resp));
+    }
+    c->resp_sent = 0;
+    flush_client(c);
+}
+
+static void on_client_event(int fd, uint32_t events, void *arg)
+{
+    struct exporter_client *c = arg;
+
+    if (c->resp_len > 0)
+    {
+        flush_client(c);
+        return;
+    }
+    if (events & (EPOLLERR | EPOLLHUP) && !(events & EPOLLIN))
+    {
+        close_client(c);
+        return;
+    }
+
+    ssize_t n = recv(fd, c->req + c->req_len, sizeof(c->req) - 1 - c->req_len, MSG_DONTWAIT);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    {
+        return;
+    }
+    if (n <= 0)
+    {
+        close_client(c);
+        return;
+    }
+    c->req_len += (size_t)n;
+    c->req[c->req_len] = '\0';
+
+    // only the request line matters, but wait for the end of the headers
+    if (strstr(c->req, "\r\n\r\n") != NULL || strstr(c->req, "\n\n") != NULL || c->req_len == sizeof(c->req) - 1)
+    {
+        handle_request(c);
+    }
+}
+
+static void on_accept(int fd, uint32_t events, void *arg)
+{
+    (void)events;
+    (void)arg;
+
+    int client_fd = accept(fd, NULL, NULL);
+    if (client_fd < 0)
+    {
+        return;
+    }
+    fcntl(client_fd, F_SETFL, O_NONBLOCK);
+    fcntl(client_fd, F_SETFD, FD_CLOEXEC);
+
+    struct exporter_client *c = NULL;
+    for (int i = 0; i < EXPORTER_MAX_CLIENTS; i++)
+    {
+        if (clients[i].fd < 0)
+        {
+            c = &clients[i];
+            break;
+        }
+        if (c == NULL || clients[i].accepted < c->accepted)
+        {
+            c = &clients[i];
+        }
+    }
+    if (c->fd >= 0)
+    {
+        close_client(c); // a stalled scraper must not lock the others out
+    }
+
+    c->fd = client_fd;
+    c->accepted = ++accept_count;
+    c->req_len = 0;
+    c->resp_len = 0;
+    c->resp_sent = 0;
+    if (event_loop_add(exporter_loop, client_fd, EPOLLIN, on_client_event, c) != 0)
+    {
+        close(client_fd);
+        c->fd = -1;
+    }
+}
+
+static int listen_unix(const char *path)
+{
+    struct sockaddr_un addr;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Error: metrics socket path too long: %s\n", path);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path); // left over from a previous run
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("metrics socket");
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static int listen_tcp(const char *spec)
+{
+    struct sockaddr_in addr;
+    const char *colon = strrchr(spec, ':');
+    char host[INET_ADDRSTRLEN] = "127.0.0.1";
+
+    if (colon != NULL && colon != spec)
+    {
+        snprintf(host, sizeof(host), "%.*s", (int)(colon - spec), spec);
+    }
+    int port = atoi(colon != NULL ? colon + 1 : spec);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (port <= 0 || port > 65535 || inet_pton(AF_INET, host, &addr.sin_addr) != 1)
+    {
+        fprintf(stderr, "Error: invalid ZZ_METRICS_LISTEN address: %s\n", spec);
+        return -1;
+    }
+
+    int one = 1;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd >= 0)
+    {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("metrics socket");
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+int exporter_start(struct event_loop *loop, struct metrics_snapshot *const *current)
+{
+    const char *spec = getenv("ZZ_METRICS_LISTEN");
+    if (spec == NULL || spec[0] == '\0')
+    {
+        return 0;
+    }
+
+    int fd = strncmp(spec, "unix:", 5) == 0 ? listen_unix(spec + 5) : listen_tcp(spec);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (listen(fd, EXPORTER_MAX_CLIENTS) < 0)
+    {
+        perror("metrics listen");
+        close(fd);
+        return -1;
+    }
+
+    for (int i = 0; i < EXPORTER_MAX_CLIENTS; i++)
+    {
+        clients[i].fd = -1;
+    }
+    exporter_loop = loop;
+    exporter_snapshot = current;
+    if (event_loop_add(loop, fd, EPOLLIN, on_accept, NULL) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    printf("Serving metrics on %s\n", spec);
+    return 1;
+}
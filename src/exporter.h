@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_EXPORTER_H
+#define _XGP_V3_EXPORTER_H
+
+#include "event_loop.h"
+#include "metrics.h"
+
+/*
+ * Optional Prometheus endpoint, enabled by ZZ_METRICS_LISTEN:
+ *
+ *   unix:/var/run/zz_xgp_screen.sock   Unix stream socket
+ *   127.0.0.1:9100                     TCP, a bare port listens on loopback
+ *
+ * Plain HTTP/1.0 served from the collector's event loop with non-blocking
+ * sockets. Scrapes are answered from the latest collected snapshot and never
+ * trigger a collection (or a modem_ctrl call) of their own.
+ */
+
+#define EXPORTER_MAX_CLIENTS 4
+
+/*
+ * current points at the collector's latest snapshot. Returns 1 if listening,
+ * 0 if disabled, -1 on error. While it listens the collector runs every
+ * group whether or not its screen is shown, so scrapes are never stale.
+ */
+int exporter_start(struct event_loop *loop, struct metrics_snapshot *const *current);
+
+#endif
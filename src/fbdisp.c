@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "fbdisp.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/fb.h>
+
+struct fbdisp
+{
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    uint8_t *fb; // visible page inside the mapping
+    uint32_t line_length;
+    int32_t width;
+    int32_t height;
+    // changes of the frame being flushed
+    uint32_t frame_bytes;
+    int32_t frame_y1;
+    int32_t frame_y2;
+};
+
+static struct fbdisp fbdisp = {.fd = -1};
+static struct fbdisp_stats stats;
+
+/* Copies the pixels between the first and last difference; bytes written */
+static uint32_t update_row(uint16_t *dst, const uint16_t *src, int32_t w)
+{
+    int32_t first = 0;
+    int32_t last = w - 1;
+
+    // only reading the mapping does not mark its pages dirty
+    while (first < w && dst[first] == src[first])
+    {
+        first++;
+    }
+    if (first == w)
+    {
+        return 0;
+    }
+    while (dst[last] == src[last])
+    {
+        last--;
+    }
+    memcpy(&dst[first], &src[first], (size_t)(last - first + 1) * sizeof(uint16_t));
+    return (uint32_t)(last - first + 1) * sizeof(uint16_t);
+}
+
+static void end_frame(void)
+{
+    stats.frames++;
+    stats.last_bytes = fbdisp.frame_bytes;
+    stats.bytes += fbdisp.frame_bytes;
+    if (fbdisp.frame_bytes == 0)
+    {
+        stats.idle_frames++;
+    }
+    else
+    {
+        uint32_t span = (uint32_t)(fbdisp.frame_y2 - fbdisp.frame_y1 + 1) * fbdisp.line_length;
+        stats.span_bytes += span;
+        if (span > stats.max_span_bytes)
+        {
+            stats.max_span_bytes = span;
+        }
+    }
+    fbdisp.frame_bytes = 0;
+    fbdisp.frame_y1 = INT32_MAX;
+    fbdisp.frame_y2 = -1;
+}
+
+static void fbdisp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    int32_t x1 = area->x1 < 0 ? 0 : area->x1;
+    int32_t y1 = area->y1 < 0 ? 0 : area->y1;
+    int32_t x2 = area->x2 >= fbdisp.width ? fbdisp.width - 1 : area->x2;
+    int32_t y2 = area->y2 >= fbdisp.height ? fbdisp.height - 1 : area->y2;
+    int32_t stride = lv_area_get_width(area);
+
+    for (int32_t y = y1; y <= y2 && x1 <= x2; y++)
+    {
+        const uint16_t *src = (const uint16_t *)px_map + (size_t)(y - area->y1) * stride + (x1 - area->x1);
+        uint16_t *dst = (uint16_t *)(fbdisp.fb + (size_t)y * fbdisp.line_length) + x1;
+        uint32_t written = update_row(dst, src, x2 - x1 + 1);
+        if (written > 0)
+        {
+            fbdisp.frame_bytes += written;
+            if (y < fbdisp.frame_y1)
+            {
+                fbdisp.frame_y1 = y;
+            }
+            if (y > fbdisp.frame_y2)
+            {
+                fbdisp.frame_y2 = y;
+            }
+        }
+    }
+
+    if (lv_display_flush_is_last(disp))
+    {
+        end_frame();
+    }
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *fbdisp_create(const char *device)
+{
+    struct fb_var_screeninfo vinfo;
+    struct fb_fix_screeninfo finfo;
+
+    fbdisp.fd = open(device, O_RDWR | O_CLOEXEC);
+    if (fbdisp.fd < 0)
+    {
+        perror("Error: cannot open framebuffer device");
+        return NULL;
+    }
+    if (ioctl(fbdisp.fd, FBIOGET_VSCREENINFO, &vinfo) != 0 || ioctl(fbdisp.fd, FBIOGET_FSCREENINFO, &finfo) != 0)
+    {
+        perror("Error: cannot query framebuffer device");
+        goto fail;
+    }
+    if (vinfo.bits_per_pixel != 16)
+    {
+        fprintf(stderr, "Error: %s is %u bpp, only RGB565 is supported\n", device, vinfo.bits_per_pixel);
+        goto fail;
+    }
+
+    fbdisp.width = (int32_t)vinfo.xres;
+    fbdisp.height = (int32_t)vinfo.yres;
+    fbdisp.line_length = finfo.line_length;
+    fbdisp.map_size = (size_t)finfo.line_length * vinfo.yres_virtual;
+    fbdisp.map = mmap(NULL, fbdisp.map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fbdisp.fd, 0);
+    if (fbdisp.map == MAP_FAILED)
+    {
+        perror("Error: cannot map framebuffer device");
+        fbdisp.map = NULL;
+        goto fail;
+    }
+    // draw into the visible page, whatever it is panned to
+    fbdisp.fb = fbdisp.map + (size_t)vinfo.yoffset * finfo.line_length + (size_t)vinfo.xoffset * sizeof(uint16_t);
+    fbdisp.frame_y1 = INT32_MAX;
+    fbdisp.frame_y2 = -1;
+
+    uint32_t buf_size = (uint32_t)fbdisp.width * FBDISP_BUFFER_ROWS * sizeof(uint16_t);
+    void *buf = malloc(buf_size);
+    if (buf == NULL)
+    {
+        goto fail;
+    }
+    lv_display_t *disp = lv_display_create(fbdisp.width, fbdisp.height);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, fbdisp_flush);
+    printf("Framebuffer %s: %dx%d, %u bytes per line\n", device, fbdisp.width, fbdisp.height, fbdisp.line_length);
+    return disp;
+
+fail:
+    if (fbdisp.map != NULL)
+    {
+        munmap(fbdisp.map, fbdisp.map_size);
+        fbdisp.map = NULL;
+    }
+    close(fbdisp.fd);
+    fbdisp.fd = -1;
+    return NULL;
+}
+
+const struct fbdisp_stats *fbdisp_get_stats(void)
+{
+    return &stats;
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_FBDISP_H
+#define _XGP_V3_FBDISP_H
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+
+/*
+ * Framebuffer display for fbtft panels. fbtft's deferred I/O sends every
+ * line between the first and the last page written to since its previous
+ * run, so the flush compares each rendered row with the mapped
+ * framebuffer and only stores the pixels that actually changed. A label
+ * that is redrawn with the same text then writes nothing at all.
+ */
+
+#define FBDISP_BUFFER_ROWS 60
+
+struct fbdisp_stats
+{
+    uint32_t frames;         // refreshes that reached the flush
+    uint32_t idle_frames;    // ... of which left the framebuffer untouched
+    uint64_t bytes;          // written to the framebuffer
+    uint64_t span_bytes;     // whole lines from first to last changed row, what fbtft sends
+    uint32_t last_bytes;     // written by the last frame
+    uint32_t max_span_bytes; // largest per-frame span
+};
+
+/* RGB565 framebuffers only; NULL if the device cannot be used */
+lv_display_t *fbdisp_create(const char *device);
+
+const struct fbdisp_stats *fbdisp_get_stats(void);
+
+#endif
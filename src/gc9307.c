@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "gc9307.h"
+#include <unistd.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GC9307_BUFFER_ROWS 40
+
+#define GC9307_SWRESET 0x01
+#define GC9307_SLPOUT 0x11
+#define GC9307_DISPON 0x29
+#define GC9307_MADCTL 0x36
+#define GC9307_COLMOD 0x3A
+#define GC9307_INTER_REG_ENABLE1 0xFE
+#define GC9307_INTER_REG_ENABLE2 0xEF
+
+#define GC9307_COLMOD_RGB565 0x05
+#define GC9307_MAX_PARAMS 16
+
+struct gc9307_init_cmd
+{
+    uint8_t cmd;
+    uint8_t len;
+    uint8_t params[GC9307_MAX_PARAMS];
+    uint16_t delay_ms; // after the command
+};
+
+/*
+ * GalaxyCore's reference sequence: power control, VCOM, source bias and
+ * gamma, behind the two inter register enable commands that unlock them.
+ */
+static const struct gc9307_init_cmd default_init[] = {
+    {GC9307_INTER_REG_ENABLE1, 0, {0}, 0},
+    {GC9307_INTER_REG_ENABLE2, 0, {0}, 0},
+    {0x85, 1, {0xC0}, 0},
+    {0x86, 1, {0x98}, 0},
+    {0x87, 1, {0x28}, 0},
+    {0x89, 1, {0x33}, 0},
+    {0x8B, 1, {0x84}, 0},
+    {0x8D, 1, {0x3B}, 0},
+    {0x8E, 1, {0x0F}, 0},
+    {0x8F, 1, {0x70}, 0},
+    {0xE8, 2, {0x13, 0x17}, 0},         // frame rate
+    {0xEC, 3, {0x57, 0x07, 0xFF}, 0},
+    {0xED, 2, {0x18, 0x09}, 0},
+    {0xC9, 1, {0x10}, 0},               // VREG
+    {0xFF, 1, {0x61}, 0},
+    {0x99, 1, {0x3A}, 0},
+    {0x9D, 1, {0x43}, 0},
+    {0x98, 1, {0x3E}, 0},
+    {0x9C, 1, {0x4B}, 0},
+    {0xF0, 6, {0x06, 0x08, 0x08, 0x06, 0x05, 0x1D}, 0}, // gamma
+    {0xF2, 6, {0x00, 0x01, 0x09, 0x07, 0x04, 0x23}, 0},
+    {0xF1, 6, {0x3B, 0x68, 0x66, 0x36, 0x35, 0x2F}, 0},
+    {0xF3, 6, {0x37, 0x6A, 0x66, 0x37, 0x35, 0x35}, 0},
+    {0xFA, 2, {0x80, 0x0F}, 0},
+    {0xBE, 1, {0x11}, 0},               // source bias
+    {0xCB, 1, {0x02}, 0},
+    {0xCD, 1, {0x22}, 0},
+    {0x9B, 1, {0xFF}, 0},
+    {0x35, 1, {0x00}, 0},               // tearing effect line on
+    {0x44, 2, {0x00, 0x0A}, 0},
+};
+
+static struct gc9307_bus *panel_bus;
+static struct gc9307_config panel_cfg;
+static bool write_failed = false;
+
+static int send_command(uint8_t cmd, const uint8_t *params, size_t len)
+{
+    if (panel_bus->write(panel_bus, false, &cmd, 1) != 0)
+    {
+        return -1;
+    }
+    if (len > 0 && panel_bus->write(panel_bus, true, params, len) != 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static int set_window(uint8_t cmd, uint16_t start, uint16_t end)
+{
+    const uint8_t params[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+    return send_command(cmd, params, sizeof(params));
+}
+
+/* Parses an init table file into *table (malloc'd); number of commands or -1 */
+static int load_init_table(const char *path, struct gc9307_init_cmd **table)
+{
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror("Error: cannot open GC9307 init table");
+        return -1;
+    }
+
+    char line[256];
+    int count = 0;
+    int cap = 0;
+    int lineno = 0;
+    *table = NULL;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        lineno++;
+        line[strcspn(line, "#\n")] = '\0';
+        char *p = line;
+        while (isspace((unsigned char)*p))
+        {
+            p++;
+        }
+        if (*p == '\0')
+        {
+            continue;
+        }
+        if (strncmp(p, "delay", 5) == 0)
+        {
+            // a delay applies to the command before it
+            if (count > 0)
+            {
+                (*table)[count - 1].delay_ms = (uint16_t)atoi(p + 5);
+            }
+            continue;
+        }
+        if (count == cap)
+        {
+            cap = cap ? cap * 2 : 32;
+            struct gc9307_init_cmd *grown = realloc(*table, (size_t)cap * sizeof(**table));
+            if (grown == NULL)
+            {
+                fclose(fp);
+                free(*table);
+                return -1;
+            }
+            *table = grown;
+        }
+
+        struct gc9307_init_cmd *c = &(*table)[count];
+        memset(c, 0, sizeof(*c));
+        int n = 0;
+        while (*p != '\0')
+        {
+            char *end;
+            unsigned long v = strtoul(p, &end, 16);
+            if (end == p || v > 0xFF || n > GC9307_MAX_PARAMS)
+            {
+                fprintf(stderr, "Error: %s:%d: expected up to %d hex bytes\n", path, lineno, GC9307_MAX_PARAMS + 1);
+                fclose(fp);
+                free(*table);
+                return -1;
+            }
+            if (n == 0)
+            {
+                c->cmd = (uint8_t)v;
+            }
+            else
+            {
+                c->params[n - 1] = (uint8_t)v;
+            }
+            n++;
+            p = end;
+            while (isspace((unsigned char)*p))
+            {
+                p++;
+            }
+        }
+        c->len = (uint8_t)(n - 1);
+        count++;
+    }
+    fclose(fp);
+    return count;
+}
+
+static int run_init_table(const struct gc9307_init_cmd *table, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (send_command(table[i].cmd, table[i].params, table[i].len) != 0)
+        {
+            return -1;
+        }
+        if (table[i].delay_ms > 0)
+        {
+            usleep(table[i].delay_ms * 1000u);
+        }
+    }
+    return 0;
+}
+
+static int panel_init(void)
+{
+    const uint8_t madctl = panel_cfg.madctl;
+    const uint8_t colmod = GC9307_COLMOD_RGB565;
+    struct gc9307_init_cmd *loaded = NULL;
+    const struct gc9307_init_cmd *table = default_init;
+    int count = (int)(sizeof(default_init) / sizeof(default_init[0]));
+
+    if (panel_cfg.init_path != NULL)
+    {
+        count = load_init_table(panel_cfg.init_path, &loaded);
+        if (count < 0)
+        {
+            return -1;
+        }
+        table = loaded;
+    }
+
+    if (panel_bus->reset != NULL)
+    {
+        panel_bus->reset(panel_bus);
+    }
+    else if (send_command(GC9307_SWRESET, NULL, 0) != 0)
+    {
+        free(loaded);
+        return -1;
+    }
+    usleep(120 * 1000);
+
+    int ret = run_init_table(table, count);
+    free(loaded);
+    if (ret != 0 ||
+        send_command(GC9307_MADCTL, &madctl, 1) != 0 ||
+        send_command(GC9307_COLMOD, &colmod, 1) != 0 ||
+        send_command(GC9307_SLPOUT, NULL, 0) != 0)
+    {
+        return -1;
+    }
+    usleep(120 * 1000);
+    return send_command(GC9307_DISPON, NULL, 0);
+}
+
+static void gc9307_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t px_count = (uint32_t)lv_area_get_width(area) * (uint32_t)lv_area_get_height(area);
+
+    // the panel takes RGB565 big-endian
+    lv_draw_sw_rgb565_swap(px_map, px_count);
+    if (set_window(GC9307_CASET, area->x1 + panel_cfg.x_offset, area->x2 + panel_cfg.x_offset) != 0 ||
+        set_window(GC9307_RASET, area->y1 + panel_cfg.y_offset, area->y2 + panel_cfg.y_offset) != 0 ||
+        send_command(GC9307_RAMWR, px_map, px_count * sizeof(uint16_t)) != 0)
+    {
+        if (!write_failed)
+        {
+            fprintf(stderr, "Warning: GC9307 panel write failed, frames are being dropped\n");
+            write_failed = true;
+        }
+    }
+    else
+    {
+        write_failed = false;
+    }
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t *gc9307_create(struct gc9307_bus *bus, const struct gc9307_config *cfg)
+{
+    panel_bus = bus;
+    panel_cfg = *cfg;
+    if (panel_init() != 0)
+    {
+        fprintf(stderr, "Error: GC9307 panel init failed\n");
+        bus->close(bus);
+        return NULL;
+    }
+
+    uint32_t buf_size = (uint32_t)cfg->width * GC9307_BUFFER_ROWS * sizeof(uint16_t);
+    void *buf = malloc(buf_size);
+    if (buf == NULL)
+    {
+        bus->close(bus);
+        return NULL;
+    }
+    lv_display_t *disp = lv_display_create(cfg->width, cfg->height);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, buf, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, gc9307_flush);
+    printf("GC9307 panel: %dx%d, MADCTL 0x%02X\n", cfg->width, cfg->height, cfg->madctl);
+    return disp;
+}
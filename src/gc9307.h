@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_GC9307_H
+#define _XGP_V3_GC9307_H
+
+#include "lvgl/lvgl.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Userspace GC9307 driver. Every LVGL flush area becomes a CASET/RASET
+ * window followed by RAMWR and the area's pixels, so nothing goes through
+ * fbtft's framebuffer and deferred I/O.
+ *
+ * The panel sits behind a bus: spidev plus a GPIO D/C line on the board,
+ * or an emulator that only records the command stream.
+ */
+
+#define GC9307_CASET 0x2A
+#define GC9307_RASET 0x2B
+#define GC9307_RAMWR 0x2C
+
+struct gc9307_bus
+{
+    // dc false: one command byte, dc true: parameters or pixel data
+    int (*write)(struct gc9307_bus *bus, bool dc, const uint8_t *buf, size_t len);
+    // pulses the RESET line; NULL if there is none, then SWRESET is used
+    void (*reset)(struct gc9307_bus *bus);
+    void (*close)(struct gc9307_bus *bus);
+};
+
+struct gc9307_config
+{
+    int32_t width;
+    int32_t height;
+    uint16_t x_offset; // of the visible area in the controller's memory
+    uint16_t y_offset;
+    uint8_t madctl;    // rotation and RGB/BGR order
+    const char *init_path; // init table replacing the built-in one, or NULL
+};
+
+#define GC9307_CONFIG_DEFAULT {.width = 320, .height = 240, .madctl = 0x60}
+
+/* Lines are "gpiochipN:offset"; reset_line may be NULL */
+struct gc9307_bus *gc9307_spi_open(const char *spidev, const char *dc_line, const char *reset_line, uint32_t speed_hz);
+/* Writes one line per command to log_path ("-" for stdout) */
+struct gc9307_bus *gc9307_emu_open(const char *log_path);
+
+/*
+ * Initialises the panel and registers it as the LVGL display. On failure the
+ * bus is closed and NULL returned.
+ *
+ * An init table file has one command per line, hex bytes with the command
+ * first, e.g. "F0 06 08 08 06 05 1D"; "delay <ms>" pauses and '#' starts a
+ * comment. MADCTL and COLMOD from the config are sent after it.
+ */
+lv_display_t *gc9307_create(struct gc9307_bus *bus, const struct gc9307_config *cfg);
+
+#endif
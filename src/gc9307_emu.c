@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "gc9307.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EMU_MAX_PARAMS 16
+
+/*
+ * Records what the driver sends, one line per command:
+ *   36 60
+ *   2A 00 00 01 3F  CASET 0..319
+ *   2C +1280        RAMWR 0,0 320x2
+ * RAMWR lines are marked with "!" when the byte count does not fill the
+ * window set by the last CASET/RASET.
+ */
+struct gc9307_emu
+{
+    struct gc9307_bus bus;
+    FILE *log;
+    bool pending; // a command whose parameters may still follow
+    uint8_t cmd;
+    uint8_t params[EMU_MAX_PARAMS];
+    size_t param_count;
+    size_t data_len;
+    uint16_t col_start, col_end;
+    uint16_t row_start, row_end;
+};
+
+static uint16_t param_u16(const struct gc9307_emu *e, size_t i)
+{
+    return (uint16_t)(e->params[i] << 8 | e->params[i + 1]);
+}
+
+static size_t window_bytes(const struct gc9307_emu *e)
+{
+    uint32_t w = e->col_end >= e->col_start ? e->col_end - e->col_start + 1u : 0;
+    uint32_t h = e->row_end >= e->row_start ? e->row_end - e->row_start + 1u : 0;
+    return (size_t)w * h * 2;
+}
+
+static void finish_command(struct gc9307_emu *e)
+{
+    if (!e->pending)
+    {
+        return;
+    }
+    e->pending = false;
+
+    fprintf(e->log, "%02X", e->cmd);
+    if (e->cmd == GC9307_RAMWR)
+    {
+        uint32_t w = e->col_end >= e->col_start ? e->col_end - e->col_start + 1u : 0;
+        uint32_t h = e->row_end >= e->row_start ? e->row_end - e->row_start + 1u : 0;
+        fprintf(e->log, " +%zu\tRAMWR %u,%u %ux%u%s\n", e->data_len, e->col_start, e->row_start, w, h,
+                e->data_len == window_bytes(e) ? "" : " !");
+        return;
+    }
+    for (size_t i = 0; i < e->param_count; i++)
+    {
+        fprintf(e->log, " %02X", e->params[i]);
+    }
+    if ((e->cmd == GC9307_CASET || e->cmd == GC9307_RASET) && e->param_count == 4)
+    {
+        uint16_t start = param_u16(e, 0);
+        uint16_t end = param_u16(e, 2);
+        if (e->cmd == GC9307_CASET)
+        {
+            e->col_start = start;
+            e->col_end = end;
+        }
+        else
+        {
+            e->row_start = start;
+            e->row_end = end;
+        }
+        fprintf(e->log, "\t%s %u..%u", e->cmd == GC9307_CASET ? "CASET" : "RASET", start, end);
+    }
+    fputc('\n', e->log);
+}
+
+static int emu_write(struct gc9307_bus *bus, bool dc, const uint8_t *buf, size_t len)
+{
+    struct gc9307_emu *e = (struct gc9307_emu *)bus;
+
+    if (!dc)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            finish_command(e);
+            e->pending = true;
+            e->cmd = buf[i];
+            e->param_count = 0;
+            e->data_len = 0;
+        }
+        return 0;
+    }
+    if (!e->pending)
+    {
+        fprintf(e->log, "-- %zu data bytes without a command\n", len);
+        return 0;
+    }
+    e->data_len += len;
+    if (e->cmd == GC9307_RAMWR)
+    {
+        // log the write as soon as the window is full
+        if (e->data_len >= window_bytes(e))
+        {
+            finish_command(e);
+        }
+        return 0;
+    }
+    for (size_t i = 0; i < len && e->param_count < EMU_MAX_PARAMS; i++)
+    {
+        e->params[e->param_count++] = buf[i];
+    }
+    return 0;
+}
+
+static void emu_reset(struct gc9307_bus *bus)
+{
+    struct gc9307_emu *e = (struct gc9307_emu *)bus;
+    finish_command(e);
+    fprintf(e->log, "-- reset\n");
+}
+
+static void emu_close(struct gc9307_bus *bus)
+{
+    struct gc9307_emu *e = (struct gc9307_emu *)bus;
+    finish_command(e);
+    if (e->log != stdout)
+    {
+        fclose(e->log);
+    }
+    free(e);
+}
+
+struct gc9307_bus *gc9307_emu_open(const char *log_path)
+{
+    struct gc9307_emu *e = calloc(1, sizeof(*e));
+    if (e == NULL)
+    {
+        return NULL;
+    }
+    e->bus.write = emu_write;
+    e->bus.reset = emu_reset;
+    e->bus.close = emu_close;
+    e->log = strcmp(log_path, "-") == 0 ? stdout : fopen(log_path, "w");
+    if (e->log == NULL)
+    {
+        perror("Error: cannot open GC9307 emulator log");
+        free(e);
+        return NULL;
+    }
+    // one line per command, readable while the screen is running
+    setvbuf(e->log, NULL, _IOLBF, 0);
+    return &e->bus;
+}
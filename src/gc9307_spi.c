@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "gc9307.h"
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+
+#define SPIDEV_BUFSIZ_PATH "/sys/module/spidev/parameters/bufsiz"
+#define SPIDEV_DEFAULT_BUFSIZ 4096
+
+struct gc9307_spi
+{
+    struct gc9307_bus bus;
+    int spi_fd;
+    int dc_fd;
+    int dc_level;
+    int reset_fd; // -1 without a reset line
+    size_t chunk; // largest transfer spidev accepts
+};
+
+/* spidev rejects transfers longer than its bufsiz module parameter */
+static size_t spidev_bufsiz(void)
+{
+    FILE *fp = fopen(SPIDEV_BUFSIZ_PATH, "r");
+    unsigned long bufsiz = 0;
+    if (fp != NULL)
+    {
+        if (fscanf(fp, "%lu", &bufsiz) != 1)
+        {
+            bufsiz = 0;
+        }
+        fclose(fp);
+    }
+    return bufsiz > 0 ? bufsiz : SPIDEV_DEFAULT_BUFSIZ;
+}
+
+/* Requests "gpiochipN:offset" as an output driven to level; line fd or -1 */
+static int request_output_line(const char *name, const char *line, bool level)
+{
+    char chip[32];
+    const char *sep = strchr(line, ':');
+    if (sep == NULL || sep == line || (size_t)(sep - line) >= sizeof(chip) - 5)
+    {
+        fprintf(stderr, "Error: %s line must be gpiochipN:offset, got %s\n", name, line);
+        return -1;
+    }
+    snprintf(chip, sizeof(chip), "/dev/%.*s", (int)(sep - line), line);
+
+    int chip_fd = open(chip, O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0)
+    {
+        perror("Error: cannot open GPIO chip");
+        return -1;
+    }
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    req.offsets[0] = (uint32_t)atoi(sep + 1);
+    req.num_lines = 1;
+    req.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+    req.config.num_attrs = 1;
+    req.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+    req.config.attrs[0].attr.values = level ? 1 : 0;
+    req.config.attrs[0].mask = 1;
+    snprintf(req.consumer, sizeof(req.consumer), "zz_xgp_screen");
+    int ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+    close(chip_fd);
+    if (ret < 0)
+    {
+        fprintf(stderr, "Error: cannot request %s line %s: %s\n", name, line, strerror(errno));
+        return -1;
+    }
+    return req.fd;
+}
+
+static int set_line(int fd, bool level)
+{
+    struct gpio_v2_line_values values = {.bits = level ? 1 : 0, .mask = 1};
+    return ioctl(fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values);
+}
+
+static int set_dc(struct gc9307_spi *s, bool dc)
+{
+    if (s->dc_level == (int)dc)
+    {
+        return 0;
+    }
+    if (set_line(s->dc_fd, dc) < 0)
+    {
+        return -1;
+    }
+    s->dc_level = dc;
+    return 0;
+}
+
+static int spi_write(struct gc9307_bus *bus, bool dc, const uint8_t *buf, size_t len)
+{
+    struct gc9307_spi *s = (struct gc9307_spi *)bus;
+
+    if (set_dc(s, dc) != 0)
+    {
+        return -1;
+    }
+    while (len > 0)
+    {
+        size_t n = len < s->chunk ? len : s->chunk;
+        ssize_t written = write(s->spi_fd, buf, n);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        buf += written;
+        len -= (size_t)written;
+    }
+    return 0;
+}
+
+/* Active-low hardware reset; the caller waits for the panel to come up */
+static void spi_reset(struct gc9307_bus *bus)
+{
+    struct gc9307_spi *s = (struct gc9307_spi *)bus;
+    set_line(s->reset_fd, false);
+    usleep(10 * 1000);
+    set_line(s->reset_fd, true);
+}
+
+static void spi_close(struct gc9307_bus *bus)
+{
+    struct gc9307_spi *s = (struct gc9307_spi *)bus;
+    if (s->reset_fd >= 0)
+    {
+        close(s->reset_fd);
+    }
+    close(s->dc_fd);
+    close(s->spi_fd);
+    free(s);
+}
+
+struct gc9307_bus *gc9307_spi_open(const char *spidev, const char *dc_line, const char *reset_line,
+                                   uint32_t speed_hz)
+{
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8;
+
+    struct gc9307_spi *s = calloc(1, sizeof(*s));
+    if (s == NULL)
+    {
+        return NULL;
+    }
+    s->bus.write = spi_write;
+    s->bus.close = spi_close;
+    s->dc_level = -1;
+    s->reset_fd = -1;
+    s->chunk = spidev_bufsiz();
+
+    s->spi_fd = open(spidev, O_RDWR | O_CLOEXEC);
+    if (s->spi_fd < 0)
+    {
+        perror("Error: cannot open spidev");
+        free(s);
+        return NULL;
+    }
+    if (ioctl(s->spi_fd, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(s->spi_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(s->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0)
+    {
+        perror("Error: cannot configure spidev");
+        close(s->spi_fd);
+        free(s);
+        return NULL;
+    }
+    s->dc_fd = request_output_line("D/C", dc_line, false);
+    if (s->dc_fd < 0)
+    {
+        close(s->spi_fd);
+        free(s);
+        return NULL;
+    }
+    if (reset_line != NULL)
+    {
+        // held high (not in reset) until the driver pulses it
+        s->reset_fd = request_output_line("reset", reset_line, true);
+        if (s->reset_fd < 0)
+        {
+            close(s->dc_fd);
+            close(s->spi_fd);
+            free(s);
+            return NULL;
+        }
+        s->bus.reset = spi_reset;
+    }
+    printf("GC9307 on %s at %u Hz, %zu byte transfers\n", spidev, speed_hz, s->chunk);
+    return &s->bus;
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "history.h"
+
+void history_init(struct history *h)
+{
+    for (int ch = 0; ch < HISTORY_CHANNELS; ch++)
+    {
+        h->head[ch] = 0;
+        for (int i = 0; i < HISTORY_LENGTH; i++)
+        {
+            h->samples[ch][i] = HISTORY_NONE;
+        }
+    }
+}
+
+int history_range(const struct history *h, enum history_channel ch, int32_t *min, int32_t *max)
+{
+    const int32_t *s = h->samples[ch];
+    int32_t lo = INT32_MAX;
+    int32_t hi = INT32_MIN;
+
+    for (int i = 0; i < HISTORY_LENGTH; i++)
+    {
+        if (s[i] == HISTORY_NONE)
+        {
+            continue;
+        }
+        if (s[i] < lo)
+        {
+            lo = s[i];
+        }
+        if (s[i] > hi)
+        {
+            hi = s[i];
+        }
+    }
+    if (hi < lo)
+    {
+        return 0;
+    }
+    *min = lo;
+    *max = hi;
+    return 1;
+}
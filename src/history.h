@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_HISTORY_H
+#define _XGP_V3_HISTORY_H
+
+#include "metrics.h"
+#include <stdint.h>
+
+/*
+ * Fixed-size sample history, one ring per channel laid out as a plain
+ * int32 array so a chart can use it directly as its data. Channels are
+ * sampled at different rates, hence a write position per channel.
+ */
+
+#define HISTORY_LENGTH 60
+#define HISTORY_NONE INT32_MAX // empty slot, same value as LV_CHART_POINT_NONE
+
+struct history
+{
+    uint16_t head[HISTORY_CHANNELS]; // next slot to write, i.e. the oldest sample
+    int32_t samples[HISTORY_CHANNELS][HISTORY_LENGTH];
+};
+
+void history_init(struct history *h);
+
+static inline void history_append(struct history *h, enum history_channel ch, int32_t value)
+{
+    uint16_t head = h->head[ch];
+    h->samples[ch][head] = value;
+    h->head[ch] = head + 1 == HISTORY_LENGTH ? 0 : head + 1;
+}
+
+/* Smallest and largest stored sample; returns 0 if the channel is empty */
+int history_range(const struct history *h, enum history_channel ch, int32_t *min, int32_t *max);
+
+#endif
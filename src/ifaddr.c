@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "ifaddr.h"
+#include "netlink.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_addr.h>
+
+#define IFADDR_INITIAL_IFACES 32 // grown as needed, routers easily have more links
+#define IFADDR_MAX_ADDRS 4
+
+struct ifaddr_iface
+{
+    int ifindex;
+    char name[IF_NAMESIZE];
+    int addr_count;
+    struct in_addr addrs[IFADDR_MAX_ADDRS]; // primary addresses, kernel order
+};
+
+static struct nl_sock rtnl = {.fd = -1};
+static struct ifaddr_iface *ifaces = NULL; // sorted by ifindex
+static int iface_count = 0;
+static int iface_cap = 0;
+static bool changed = false;
+
+static struct ifaddr_iface *iface_find(int ifindex)
+{
+    for (int i = 0; i < iface_count; i++)
+    {
+        if (ifaces[i].ifindex == ifindex)
+        {
+            return &ifaces[i];
+        }
+    }
+    return NULL;
+}
+
+static struct ifaddr_iface *iface_insert(int ifindex)
+{
+    int pos = 0;
+
+    if (iface_count == iface_cap)
+    {
+        int new_cap = iface_cap ? iface_cap * 2 : IFADDR_INITIAL_IFACES;
+        struct ifaddr_iface *grown = realloc(ifaces, (size_t)new_cap * sizeof(ifaces[0]));
+        if (grown == NULL)
+        {
+            fprintf(stderr, "Warning: out of memory, interface %d is not tracked\n", ifindex);
+            return NULL;
+        }
+        ifaces = grown;
+        iface_cap = new_cap;
+    }
+    while (pos < iface_count && ifaces[pos].ifindex < ifindex)
+    {
+        pos++;
+    }
+    memmove(&ifaces[pos + 1], &ifaces[pos], (iface_count - pos) * sizeof(ifaces[0]));
+    iface_count++;
+    memset(&ifaces[pos], 0, sizeof(ifaces[pos]));
+    ifaces[pos].ifindex = ifindex;
+    return &ifaces[pos];
+}
+
+static void iface_remove(struct ifaddr_iface *iface)
+{
+    int pos = (int)(iface - ifaces);
+    memmove(&ifaces[pos], &ifaces[pos + 1], (iface_count - pos - 1) * sizeof(ifaces[0]));
+    iface_count--;
+}
+
+static void handle_link_msg(const struct nlmsghdr *nlh)
+{
+    const struct ifinfomsg *ifi = NLMSG_DATA(nlh);
+    const struct nlattr *tb[IFLA_MAX + 1];
+
+    if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifi)))
+    {
+        return;
+    }
+
+    struct ifaddr_iface *iface = iface_find(ifi->ifi_index);
+    if (nlh->nlmsg_type == RTM_DELLINK)
+    {
+        if (iface != NULL)
+        {
+            iface_remove(iface);
+            changed = true;
+        }
+        return;
+    }
+
+    nl_parse_attrs((const char *)ifi + NLMSG_ALIGN(sizeof(*ifi)),
+                   nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*ifi)), tb, IFLA_MAX);
+    if (tb[IFLA_IFNAME] == NULL)
+    {
+        return;
+    }
+    if (iface == NULL && (iface = iface_insert(ifi->ifi_index)) == NULL)
+    {
+        return;
+    }
+
+    char name[IF_NAMESIZE];
+    snprintf(name, sizeof(name), "%.*s", nl_attr_len(tb[IFLA_IFNAME]), (const char *)nl_attr_data(tb[IFLA_IFNAME]));
+    if (strcmp(name, iface->name) != 0)
+    {
+        strcpy(iface->name, name);
+        changed = true;
+    }
+}
+
+static void handle_addr_msg(const struct nlmsghdr *nlh)
+{
+    const struct ifaddrmsg *ifa = NLMSG_DATA(nlh);
+    const struct nlattr *tb[IFA_MAX + 1];
+
+    if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifa)) || ifa->ifa_family != AF_INET)
+    {
+        return;
+    }
+    nl_parse_attrs((const char *)ifa + NLMSG_ALIGN(sizeof(*ifa)),
+                   nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*ifa)), tb, IFA_MAX);
+
+    uint32_t flags = ifa->ifa_flags;
+    if (tb[IFA_FLAGS] != NULL && nl_attr_len(tb[IFA_FLAGS]) >= 4)
+    {
+        memcpy(&flags, nl_attr_data(tb[IFA_FLAGS]), sizeof(flags));
+    }
+    // SIOCGIFADDR reports ifa_local of the first primary address
+    const struct nlattr *local = tb[IFA_LOCAL] ? tb[IFA_LOCAL] : tb[IFA_ADDRESS];
+    if ((flags & IFA_F_SECONDARY) || local == NULL || nl_attr_len(local) != 4)
+    {
+        return;
+    }
+
+    struct ifaddr_iface *iface = iface_find((int)ifa->ifa_index);
+    if (iface == NULL)
+    {
+        return;
+    }
+    // alias labels (eth1:1) are separate names for SIOCGIFADDR
+    if (tb[IFA_LABEL] != NULL && strncmp(nl_attr_data(tb[IFA_LABEL]), iface->name, nl_attr_len(tb[IFA_LABEL])) != 0)
+    {
+        return;
+    }
+
+    struct in_addr addr;
+    memcpy(&addr, nl_attr_data(local), sizeof(addr));
+
+    int i;
+    for (i = 0; i < iface->addr_count; i++)
+    {
+        if (iface->addrs[i].s_addr == addr.s_addr)
+        {
+            break;
+        }
+    }
+    if (nlh->nlmsg_type == RTM_DELADDR)
+    {
+        if (i < iface->addr_count)
+        {
+            memmove(&iface->addrs[i], &iface->addrs[i + 1], (iface->addr_count - i - 1) * sizeof(addr));
+            iface->addr_count--;
+            changed = true;
+        }
+    }
+    else if (i == iface->addr_count && iface->addr_count < IFADDR_MAX_ADDRS)
+    {
+        iface->addrs[iface->addr_count++] = addr;
+        changed = true;
+    }
+}
+
+static void handle_rtnl_msg(const struct nlmsghdr *nlh, void *arg)
+{
+    (void)arg;
+    switch (nlh->nlmsg_type)
+    {
+    case RTM_NEWLINK:
+    case RTM_DELLINK:
+        handle_link_msg(nlh);
+        break;
+    case RTM_NEWADDR:
+    case RTM_DELADDR:
+        handle_addr_msg(nlh);
+        break;
+    }
+}
+
+static int dump_request(uint16_t type)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct rtgenmsg gen;
+    } req;
+
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(req.gen));
+    req.nlh.nlmsg_type = type;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.gen.rtgen_family = type == RTM_GETADDR ? AF_INET : AF_UNSPEC;
+
+    int seq = nl_send(&rtnl, &req.nlh);
+    if (seq < 0)
+    {
+        return -errno;
+    }
+    return nl_recv_reply(&rtnl, (uint32_t)seq, handle_rtnl_msg, NULL);
+}
+
+static int resync(void)
+{
+    int ret;
+
+    do
+    {
+        iface_count = 0;
+        ret = dump_request(RTM_GETLINK);
+        if (ret == 0)
+        {
+            ret = dump_request(RTM_GETADDR);
+        }
+    } while (ret == -ENOBUFS || ret == -EBUSY || ret == -EINTR);
+    changed = true;
+    return ret;
+}
+
+struct link_dump
+{
+    uint32_t seq;
+    nl_msg_cb cb;
+    void *arg;
+};
+
+/* The cache sees everything; the other collector only its own dump's replies */
+static void handle_link_dump_msg(const struct nlmsghdr *nlh, void *arg)
+{
+    const struct link_dump *dump = arg;
+    handle_rtnl_msg(nlh, NULL);
+    if (nlh->nlmsg_seq == dump->seq)
+    {
+        dump->cb(nlh, dump->arg);
+    }
+}
+
+int ifaddr_dump_links(nl_msg_cb cb, void *arg)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct ifinfomsg ifi;
+    } req;
+
+    if (rtnl.fd < 0)
+    {
+        return -ENOTCONN;
+    }
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(req.ifi));
+    req.nlh.nlmsg_type = RTM_GETLINK;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    int seq = nl_send(&rtnl, &req.nlh);
+    if (seq < 0)
+    {
+        return -errno;
+    }
+    struct link_dump dump = {.seq = (uint32_t)seq, .cb = cb, .arg = arg};
+    int ret = nl_recv_reply(&rtnl, dump.seq, handle_link_dump_msg, &dump);
+    if (ret == -ENOBUFS)
+    {
+        // notifications were lost while dumping
+        resync();
+    }
+    return ret;
+}
+
+int ifaddr_init(void)
+{
+    if (nl_open(&rtnl, NETLINK_ROUTE, RTMGRP_LINK | RTMGRP_IPV4_IFADDR) != 0)
+    {
+        return -1;
+    }
+    int ret = resync();
+    if (ret < 0)
+    {
+        fprintf(stderr, "Warning: interface dump failed: %s\n", strerror(-ret));
+        nl_close(&rtnl);
+        return -1;
+    }
+    return 0;
+}
+
+int ifaddr_fd(void)
+{
+    return rtnl.fd;
+}
+
+int ifaddr_poll(void)
+{
+    if (rtnl.fd < 0)
+    {
+        return 0;
+    }
+    if (nl_recv_pending(&rtnl, handle_rtnl_msg, NULL) == -ENOBUFS)
+    {
+        resync();
+    }
+    bool ret = changed;
+    changed = false;
+    return ret;
+}
+
+static int format_first_addr(const struct ifaddr_iface *iface, char *ip_addr, size_t ip_addr_len)
+{
+    if (iface->addr_count == 0 || ip_addr_len < INET_ADDRSTRLEN)
+    {
+        return -1;
+    }
+    return inet_ntop(AF_INET, &iface->addrs[0], ip_addr, ip_addr_len) != NULL ? 0 : -1;
+}
+
+int ifaddr_get_ipv4(const char *ifname, char *ip_addr, size_t ip_addr_len)
+{
+    for (int i = 0; i < iface_count; i++)
+    {
+        if (strcmp(ifaces[i].name, ifname) == 0)
+        {
+            return format_first_addr(&ifaces[i], ip_addr, ip_addr_len);
+        }
+    }
+    return -1; // 接口不存在或没有IP地址
+}
+
+int ifaddr_get_first_ipv4(const char *prefix, char *ip_addr, size_t ip_addr_len)
+{
+    size_t prefix_len = strlen(prefix);
+    for (int i = 0; i < iface_count; i++)
+    {
+        if (strncmp(ifaces[i].name, prefix, prefix_len) == 0 &&
+            format_first_addr(&ifaces[i], ip_addr, ip_addr_len) == 0)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
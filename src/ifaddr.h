@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_IFADDR_H
+#define _XGP_V3_IFADDR_H
+
+#include "netlink.h"
+#include <stddef.h>
+
+/*
+ * Interface / IPv4 address cache fed by RTNLGRP_LINK and RTNLGRP_IPV4_IFADDR.
+ *
+ * After the initial dump nothing is queried again: lookups are served from
+ * memory and ifaddr_poll() only reads when the socket has events queued.
+ */
+
+int ifaddr_init(void);
+int ifaddr_fd(void);
+
+/* Applies queued events; returns 1 if any interface or address changed */
+int ifaddr_poll(void);
+
+/*
+ * Runs an RTM_GETLINK dump on the cache's socket for another collector, so
+ * that there is only one NETLINK_ROUTE socket. cb sees the dump replies;
+ * notifications arriving meanwhile still reach the cache. 0 or -errno.
+ */
+int ifaddr_dump_links(nl_msg_cb cb, void *arg);
+
+/* Primary IPv4 address of the interface, like SIOCGIFADDR. 0 on success */
+int ifaddr_get_ipv4(const char *ifname, char *ip_addr, size_t ip_addr_len);
+
+/* Same for the lowest-index interface whose name starts with prefix and has an address */
+int ifaddr_get_first_ipv4(const char *prefix, char *ip_addr, size_t ip_addr_len);
+
+#endif
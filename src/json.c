@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "json.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+struct json_reader
+{
+    char *p;
+    char *end;
+    json_cb cb;
+    void *arg;
+};
+
+static void skip_ws(struct json_reader *r)
+{
+    while (r->p < r->end && (*r->p == ' ' || *r->p == '\t' || *r->p == '\n' || *r->p == '\r'))
+    {
+        r->p++;
+    }
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static int read_hex4(const char *s, const char *end, uint32_t *out)
+{
+    uint32_t v = 0;
+    if (end - s < 4)
+    {
+        return -1;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        int h = hex_value(s[i]);
+        if (h < 0)
+        {
+            return -1;
+        }
+        v = (v << 4) | (uint32_t)h;
+    }
+    *out = v;
+    return 0;
+}
+
+static char *put_utf8(char *dst, uint32_t cp)
+{
+    if (cp < 0x80)
+    {
+        *dst++ = (char)cp;
+    }
+    else if (cp < 0x800)
+    {
+        *dst++ = (char)(0xC0 | (cp >> 6));
+        *dst++ = (char)(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        *dst++ = (char)(0xE0 | (cp >> 12));
+        *dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *dst++ = (char)(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        *dst++ = (char)(0xF0 | (cp >> 18));
+        *dst++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+        *dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+        *dst++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return dst;
+}
+
+/* Unescapes the string at r->p (after the opening quote) in place */
+static int read_string(struct json_reader *r, char **str, size_t *len)
+{
+    char *src = r->p;
+    char *dst = r->p;
+
+    *str = dst;
+    while (src < r->end && *src != '"')
+    {
+        if (*src != '\\')
+        {
+            *dst++ = *src++;
+            continue;
+        }
+        if (++src >= r->end)
+        {
+            return -1;
+        }
+        char c = *src++;
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            *dst++ = c;
+            break;
+        case 'b':
+            *dst++ = '\b';
+            break;
+        case 'f':
+            *dst++ = '\f';
+            break;
+        case 'n':
+            *dst++ = '\n';
+            break;
+        case 'r':
+            *dst++ = '\r';
+            break;
+        case 't':
+            *dst++ = '\t';
+            break;
+        case 'u':
+        {
+            uint32_t cp, low;
+            if (read_hex4(src, r->end, &cp) != 0)
+            {
+                return -1;
+            }
+            src += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF && src + 1 < r->end && src[0] == '\\' && src[1] == 'u' &&
+                read_hex4(src + 2, r->end, &low) == 0 && low >= 0xDC00 && low <= 0xDFFF)
+            {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                src += 6;
+            }
+            // the escape is at least 6 bytes and the UTF-8 form at most 4
+            dst = put_utf8(dst, cp);
+            break;
+        }
+        default:
+            return -1;
+        }
+    }
+    if (src >= r->end)
+    {
+        return -1;
+    }
+    *len = (size_t)(dst - *str);
+    *dst = '\0'; // dst <= src, which points at the closing quote
+    r->p = src + 1;
+    return 0;
+}
+
+static int emit(struct json_reader *r, enum json_event ev, const char *str, size_t len)
+{
+    return r->cb(ev, str, len, r->arg) != 0 ? 1 : 0;
+}
+
+static int read_literal(struct json_reader *r, const char *word, enum json_event ev)
+{
+    size_t n = strlen(word);
+    if ((size_t)(r->end - r->p) < n || memcmp(r->p, word, n) != 0)
+    {
+        return -1;
+    }
+    r->p += n;
+    return emit(r, ev, word, n);
+}
+
+static int read_number(struct json_reader *r)
+{
+    char *start = r->p;
+    while (r->p < r->end && (strchr("+-.eE", *r->p) != NULL || (*r->p >= '0' && *r->p <= '9')))
+    {
+        r->p++;
+    }
+    if (r->p == start)
+    {
+        return -1;
+    }
+    // the number is followed by a delimiter we have not consumed yet, so
+    // the callback gets a length instead of a terminator
+    return emit(r, JSON_NUMBER, start, (size_t)(r->p - start));
+}
+
+int json_parse(char *buf, size_t len, json_cb cb, void *arg)
+{
+    struct json_reader r = {.p = buf, .end = buf + len, .cb = cb, .arg = arg};
+    char stack[JSON_MAX_DEPTH]; // '{' or '['
+    int depth = 0;
+    bool expect_value = true;   // false right after a complete value
+    int ret;
+
+    while (1)
+    {
+        skip_ws(&r);
+        if (r.p >= r.end)
+        {
+            return depth == 0 && !expect_value ? 0 : -1;
+        }
+
+        char c = *r.p;
+        if (!expect_value)
+        {
+            if (depth == 0)
+            {
+                return 0; // trailing data after the top-level value
+            }
+            r.p++;
+            if (c == ',')
+            {
+                expect_value = true;
+                if (stack[depth - 1] == '{')
+                {
+                    skip_ws(&r);
+                    if (r.p >= r.end || *r.p != '"')
+                    {
+                        return -1;
+                    }
+                    goto read_key;
+                }
+                continue;
+            }
+            if ((c == '}' && stack[depth - 1] == '{') || (c == ']' && stack[depth - 1] == '['))
+            {
+                depth--;
+                if ((ret = emit(&r, c == '}' ? JSON_OBJECT_END : JSON_ARRAY_END, NULL, 0)) != 0)
+                {
+                    return ret;
+                }
+                continue;
+            }
+            return -1;
+        }
+
+        switch (c)
+        {
+        case '{':
+        case '[':
+            if (depth >= JSON_MAX_DEPTH)
+            {
+                return -1;
+            }
+            stack[depth++] = c;
+            r.p++;
+            if ((ret = emit(&r, c == '{' ? JSON_OBJECT_BEGIN : JSON_ARRAY_BEGIN, NULL, 0)) != 0)
+            {
+                return ret;
+            }
+            skip_ws(&r);
+            if (r.p < r.end && (*r.p == '}' || *r.p == ']'))
+            {
+                expect_value = false; // empty container, the closer is handled above
+                continue;
+            }
+            if (c == '{')
+            {
+                if (r.p >= r.end || *r.p != '"')
+                {
+                    return -1;
+                }
+                goto read_key;
+            }
+            continue;
+        case '"':
+        {
+            char *str;
+            size_t str_len;
+            r.p++;
+            if (read_string(&r, &str, &str_len) != 0)
+            {
+                return -1;
+            }
+            ret = emit(&r, JSON_STRING, str, str_len);
+            break;
+        }
+        case 't':
+            ret = read_literal(&r, "true", JSON_TRUE);
+            break;
+        case 'f':
+            ret = read_literal(&r, "false", JSON_FALSE);
+            break;
+        case 'n':
+            ret = read_literal(&r, "null", JSON_NULL);
+            break;
+        default:
+            ret = read_number(&r);
+            break;
+        }
+        if (ret != 0)
+        {
+            return ret;
+        }
+        expect_value = false;
+        continue;
+
+    read_key:
+    {
+        char *key;
+        size_t key_len;
+        r.p++;
+        if (read_string(&r, &key, &key_len) != 0)
+        {
+            return -1;
+        }
+        skip_ws(&r);
+        if (r.p >= r.end || *r.p != ':')
+        {
+            return -1;
+        }
+        r.p++;
+        if ((ret = emit(&r, JSON_KEY, key, key_len)) != 0)
+        {
+            return ret;
+        }
+        expect_value = true;
+    }
+    }
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_JSON_H
+#define _XGP_V3_JSON_H
+
+#include <stddef.h>
+
+/*
+ * Event-based JSON reader: one pass over the buffer, no tree, no allocation.
+ * Strings are unescaped in place, so every str passed to the callback points
+ * into buf and is NUL-terminated. Numbers and literals are passed as their
+ * source text.
+ */
+
+enum json_event
+{
+    JSON_OBJECT_BEGIN,
+    JSON_OBJECT_END,
+    JSON_ARRAY_BEGIN,
+    JSON_ARRAY_END,
+    JSON_KEY,
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_TRUE,
+    JSON_FALSE,
+    JSON_NULL,
+};
+
+#define JSON_MAX_DEPTH 32
+
+/* Return non-zero to stop parsing */
+typedef int (*json_cb)(enum json_event ev, const char *str, size_t len, void *arg);
+
+/* Returns 0 on success, 1 if stopped by the callback, -1 on malformed input */
+int json_parse(char *buf, size_t len, json_cb cb, void *arg);
+
+#endif
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "linkstats.h"
+#include "ifaddr.h"
+#include "netlink.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <net/if.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+
+#define LINKSTATS_INITIAL_IFACES 32 // grown as needed
+#define LINKSTATS_EWMA_SHIFT 2    // a new sample weighs 1/4
+#define LINKSTATS_MAX_GAP_MS 5000 // longer gaps (screen hidden) restart the average
+
+struct link_entry
+{
+    int ifindex;
+    char name[IF_NAMESIZE];
+    bool seen;     // present in the current dump
+    bool has_rate; // two samples taken since the baseline
+    bool reseed;   // next rate replaces the average instead of blending in
+    uint64_t rx_bytes;
+    uint64_t tx_bytes;
+    uint64_t sampled_ms;
+    struct link_rate rate;
+};
+
+static struct link_entry *links = NULL;
+static int link_count = 0;
+static int link_cap = 0;
+static uint64_t dump_ms;
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* Bytes since the last sample, or -1 if the counter was reset */
+static int64_t counter_delta(uint64_t prev, uint64_t cur)
+{
+    if (cur >= prev)
+    {
+        return (int64_t)(cur - prev);
+    }
+    // some drivers only keep 32-bit counters, which wrap inside the 64-bit field
+    if (prev <= UINT32_MAX && cur <= UINT32_MAX)
+    {
+        return (int64_t)(cur + ((uint64_t)1 << 32) - prev);
+    }
+    return -1;
+}
+
+/* Steps are rounded up so the average can still settle on 0 */
+static uint64_t ewma(uint64_t avg, uint64_t sample)
+{
+    uint64_t round = ((uint64_t)1 << LINKSTATS_EWMA_SHIFT) - 1;
+    if (sample >= avg)
+    {
+        return avg + ((sample - avg + round) >> LINKSTATS_EWMA_SHIFT);
+    }
+    return avg - ((avg - sample + round) >> LINKSTATS_EWMA_SHIFT);
+}
+
+static void restart_baseline(struct link_entry *link, uint64_t rx_bytes, uint64_t tx_bytes)
+{
+    link->rx_bytes = rx_bytes;
+    link->tx_bytes = tx_bytes;
+    link->sampled_ms = dump_ms;
+    link->reseed = true;
+}
+
+static void update_entry(struct link_entry *link, uint64_t rx_bytes, uint64_t tx_bytes)
+{
+    uint64_t elapsed = dump_ms - link->sampled_ms;
+    if (elapsed == 0)
+    {
+        return;
+    }
+    int64_t rx_delta = counter_delta(link->rx_bytes, rx_bytes);
+    int64_t tx_delta = counter_delta(link->tx_bytes, tx_bytes);
+    if (elapsed > LINKSTATS_MAX_GAP_MS || rx_delta < 0 || tx_delta < 0)
+    {
+        restart_baseline(link, rx_bytes, tx_bytes);
+        return;
+    }
+
+    struct link_rate sample = {
+        .rx_bps = (uint64_t)rx_delta * 8 * 1000 / elapsed,
+        .tx_bps = (uint64_t)tx_delta * 8 * 1000 / elapsed,
+    };
+    if (link->reseed)
+    {
+        link->rate = sample;
+        link->reseed = false;
+    }
+    else
+    {
+        link->rate.rx_bps = ewma(link->rate.rx_bps, sample.rx_bps);
+        link->rate.tx_bps = ewma(link->rate.tx_bps, sample.tx_bps);
+    }
+    link->has_rate = true;
+    link->rx_bytes = rx_bytes;
+    link->tx_bytes = tx_bytes;
+    link->sampled_ms = dump_ms;
+}
+
+static void handle_link_msg(const struct nlmsghdr *nlh, void *arg)
+{
+    (void)arg;
+    const struct ifinfomsg *ifi = NLMSG_DATA(nlh);
+    const struct nlattr *tb[IFLA_MAX + 1];
+    struct rtnl_link_stats64 stats;
+
+    if (nlh->nlmsg_type != RTM_NEWLINK || nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifi)))
+    {
+        return;
+    }
+    nl_parse_attrs((const char *)ifi + NLMSG_ALIGN(sizeof(*ifi)),
+                   nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*ifi)), tb, IFLA_MAX);
+    // older kernels send a shorter struct, the byte counters are always in it
+    if (tb[IFLA_IFNAME] == NULL || tb[IFLA_STATS64] == NULL ||
+        nl_attr_len(tb[IFLA_STATS64]) < (int)(offsetof(struct rtnl_link_stats64, tx_bytes) + sizeof(stats.tx_bytes)))
+    {
+        return;
+    }
+    memset(&stats, 0, sizeof(stats));
+    size_t stats_len = (size_t)nl_attr_len(tb[IFLA_STATS64]);
+    memcpy(&stats, nl_attr_data(tb[IFLA_STATS64]), stats_len < sizeof(stats) ? stats_len : sizeof(stats));
+
+    char name[IF_NAMESIZE];
+    snprintf(name, sizeof(name), "%.*s", nl_attr_len(tb[IFLA_IFNAME]), (const char *)nl_attr_data(tb[IFLA_IFNAME]));
+
+    struct link_entry *link = NULL;
+    for (int i = 0; i < link_count; i++)
+    {
+        if (links[i].ifindex == ifi->ifi_index)
+        {
+            link = &links[i];
+            break;
+        }
+    }
+    if (link == NULL)
+    {
+        if (link_count == link_cap)
+        {
+            int new_cap = link_cap ? link_cap * 2 : LINKSTATS_INITIAL_IFACES;
+            struct link_entry *grown = realloc(links, (size_t)new_cap * sizeof(links[0]));
+            if (grown == NULL)
+            {
+                fprintf(stderr, "Warning: out of memory, no statistics for %s\n", name);
+                return;
+            }
+            links = grown;
+            link_cap = new_cap;
+        }
+        link = &links[link_count++];
+        memset(link, 0, sizeof(*link));
+        link->ifindex = ifi->ifi_index;
+        strcpy(link->name, name);
+        restart_baseline(link, stats.rx_bytes, stats.tx_bytes);
+    }
+    else if (strcmp(link->name, name) != 0)
+    {
+        // renamed: it is a different link as far as the screen is concerned
+        strcpy(link->name, name);
+        link->has_rate = false;
+        restart_baseline(link, stats.rx_bytes, stats.tx_bytes);
+    }
+    else
+    {
+        update_entry(link, stats.rx_bytes, stats.tx_bytes);
+    }
+    link->seen = true;
+}
+
+int linkstats_sample(void)
+{
+    for (int i = 0; i < link_count; i++)
+    {
+        links[i].seen = false;
+    }
+    dump_ms = monotonic_ms();
+    // on the interface cache's socket, see ifaddr.h
+    int ret = ifaddr_dump_links(handle_link_msg, NULL);
+    if (ret == -ENOTCONN)
+    {
+        return -1; // the cache could not open its socket, already reported
+    }
+    if (ret < 0)
+    {
+        fprintf(stderr, "Warning: link statistics dump failed: %s\n", strerror(-ret));
+        return -1;
+    }
+
+    // drop interfaces that went away
+    int kept = 0;
+    for (int i = 0; i < link_count; i++)
+    {
+        if (links[i].seen)
+        {
+            links[kept++] = links[i];
+        }
+    }
+    link_count = kept;
+    return 0;
+}
+
+int linkstats_get(const char *ifname, struct link_rate *rate)
+{
+    for (int i = 0; i < link_count; i++)
+    {
+        if (strcmp(links[i].name, ifname) == 0)
+        {
+            if (!links[i].has_rate)
+            {
+                return -1;
+            }
+            *rate = links[i].rate;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int linkstats_get_prefix(const char *prefix, struct link_rate *rate)
+{
+    size_t prefix_len = strlen(prefix);
+    int found = -1;
+
+    rate->rx_bps = 0;
+    rate->tx_bps = 0;
+    for (int i = 0; i < link_count; i++)
+    {
+        if (strncmp(links[i].name, prefix, prefix_len) == 0 && links[i].has_rate)
+        {
+            rate->rx_bps += links[i].rate.rx_bps;
+            rate->tx_bps += links[i].rate.tx_bps;
+            found = 0;
+        }
+    }
+    return found;
+}
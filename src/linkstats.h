@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_LINKSTATS_H
+#define _XGP_V3_LINKSTATS_H
+
+#include <stdint.h>
+
+/*
+ * Interface traffic rates for the Throughput screen.
+ *
+ * linkstats_sample() does one RTM_GETLINK dump and reads the IFLA_STATS64
+ * byte counters of every interface from it. Rates are computed from the
+ * counter deltas (32-bit wraps are undone, resets restart the baseline)
+ * and smoothed with an EWMA.
+ */
+
+struct link_rate
+{
+    uint64_t rx_bps;
+    uint64_t tx_bps;
+};
+
+/* Dumps all interfaces once; 0 on success */
+int linkstats_sample(void);
+
+/* Smoothed rate of the interface, 0 on success, -1 if missing or not sampled twice yet */
+int linkstats_get(const char *ifname, struct link_rate *rate);
+
+/* Sum over every interface whose name starts with prefix (wwan0, wwan1, ...) */
+int linkstats_get_prefix(const char *prefix, struct link_rate *rate);
+
+#endif
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_METRICS_H
+#define _XGP_V3_METRICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UNKNOWN_VALUE_REPLACE_STRING "未知"
+#define STALE_VALUE_REPLACE_STRING "响应超时"
+#define UNKNOWN_IP_REPLACE_STRING "无IP地址或接口不存在"
+#define DEFAULT_VALUE_SIZE 64
+
+#define MODEM_SIGNAL_COUNT 3
+#define ARP_IFACE_SLOTS 8
+#define CPU_CORE_SLOTS 8
+
+/* Metric groups, one per carousel screen that shows collected values */
+enum metric_group
+{
+    METRIC_GROUP_SYSTEM_INFO = 1 << 0,
+    METRIC_GROUP_SYSTEM_STATUS = 1 << 1,
+    METRIC_GROUP_NETWORK_INFO = 1 << 2,
+    METRIC_GROUP_MODEM = 1 << 3,
+    METRIC_GROUP_THROUGHPUT = 1 << 4,
+    METRIC_GROUP_ALWAYS = 1 << 5, // no screen of its own, collected whatever is shown
+};
+
+#define METRIC_GROUP_ALL (METRIC_GROUP_SYSTEM_INFO | METRIC_GROUP_SYSTEM_STATUS | \
+                          METRIC_GROUP_NETWORK_INFO | METRIC_GROUP_MODEM | METRIC_GROUP_THROUGHPUT | \
+                          METRIC_GROUP_ALWAYS)
+
+/* Numeric samples kept as history, in fixed point */
+enum history_channel
+{
+    HISTORY_LOAD,      // 1 min load average x100
+    HISTORY_MEMORY,    // used memory in 0.01 %
+    HISTORY_CONNTRACK, // tracked connections
+    HISTORY_SIGNAL1,   // modem signal channels, in their own unit
+    HISTORY_SIGNAL2,
+    HISTORY_SIGNAL3,
+    HISTORY_CHANNELS,
+};
+
+struct arp_iface
+{
+    char name[16];
+    int online;
+};
+
+struct cpu_core_usage
+{
+    uint8_t busy;    // % of the last period not idle or waiting for I/O
+    uint8_t softirq; // % of the last period spent in softirq (NAT, forwarding)
+};
+
+struct modem_signal
+{
+    char name[DEFAULT_VALUE_SIZE];
+    int value;
+    int min;
+    int max;
+    char unit[DEFAULT_VALUE_SIZE];
+};
+
+struct modem_metrics
+{
+    char revision[DEFAULT_VALUE_SIZE];
+    char temperature[DEFAULT_VALUE_SIZE];
+    char voltage[DEFAULT_VALUE_SIZE];
+    char connect[DEFAULT_VALUE_SIZE];
+    char sim[DEFAULT_VALUE_SIZE];
+    char isp[DEFAULT_VALUE_SIZE];
+    char cqi[DEFAULT_VALUE_SIZE];
+    char ambr[DEFAULT_VALUE_SIZE];
+    char networkmode[DEFAULT_VALUE_SIZE];
+    struct modem_signal signal[MODEM_SIGNAL_COUNT];
+};
+
+/*
+ * One complete set of display values, produced by the collector thread and
+ * consumed read-only by the UI thread. All strings are ready to be handed to
+ * lv_label_set_text() as-is.
+ */
+struct metrics_snapshot
+{
+    uint32_t seq;
+    uint32_t modem_seq; // 0 until the first modem poll has finished
+
+    char hostname[DEFAULT_VALUE_SIZE];
+    char sys_version[DEFAULT_VALUE_SIZE];
+    char build_id[DEFAULT_VALUE_SIZE];
+    char kernel_version[DEFAULT_VALUE_SIZE];
+    char load_avg[DEFAULT_VALUE_SIZE];
+    char memory[DEFAULT_VALUE_SIZE];
+    char uptime[DEFAULT_VALUE_SIZE];
+    char local_time[DEFAULT_VALUE_SIZE];
+    char soc_temp[DEFAULT_VALUE_SIZE];
+    int32_t soc_temp_mc; // hottest thermal zone, INT32_MIN if none could be read
+    bool overheat;       // a thermal zone is over its threshold
+    char modem_ip[DEFAULT_VALUE_SIZE];
+    char wan_ip[DEFAULT_VALUE_SIZE];
+    char lan_ip[DEFAULT_VALUE_SIZE];
+    char active_connect[DEFAULT_VALUE_SIZE];
+    char arp_count[DEFAULT_VALUE_SIZE];
+    int arp_iface_count;
+    struct arp_iface arp_ifaces[ARP_IFACE_SLOTS];
+    int cpu_count; // 0 until two /proc/stat samples have been taken
+    struct cpu_core_usage cpu[CPU_CORE_SLOTS];
+    // "DL / UL" per link, all three come from the same RTM_GETLINK dump
+    char throughput_modem[DEFAULT_VALUE_SIZE];
+    char throughput_wan[DEFAULT_VALUE_SIZE];
+    char throughput_lan[DEFAULT_VALUE_SIZE];
+
+    struct modem_metrics modem;
+
+    // latest sample per channel; seq changes whenever a new one is taken
+    int32_t samples[HISTORY_CHANNELS];
+    uint32_t sample_seq[HISTORY_CHANNELS];
+    uint64_t sample_ms[HISTORY_CHANNELS];        // CLOCK_MONOTONIC when taken
+    uint32_t sample_period_ms[HISTORY_CHANNELS]; // interval it was taken at, 0 if none
+};
+
+#endif
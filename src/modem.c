@@ -0,0 +1,623 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "modem.h"
+#include "event_loop.h"
+#include "json.h"
+#include "modem_record.h"
+#include "modem_worker.h"
+#include "subprocess.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MODEM_PROGRESS_SLOTS 8
+
+// keys copied verbatim from the modem_info list, see modem_info.py
+enum modem_key
+{
+    MODEM_KEY_REVISION,
+    MODEM_KEY_TEMPERATURE,
+    MODEM_KEY_VOLTAGE,
+    MODEM_KEY_CONNECT_STATUS,
+    MODEM_KEY_SIM_STATUS,
+    MODEM_KEY_SIM_STATUS_LOWER,
+    MODEM_KEY_ISP,
+    MODEM_KEY_CQI_UL,
+    MODEM_KEY_CQI_DL,
+    MODEM_KEY_AMBR_UL,
+    MODEM_KEY_AMBR_DL,
+    MODEM_KEY_NETWORK_MODE,
+    MODEM_KEY_MMC, // https://github.com/FUjr/QModem/pull/66
+    MODEM_KEY_MCC,
+    MODEM_KEY_MNC,
+    MODEM_KEY_COUNT,
+};
+
+static const char *const modem_key_names[MODEM_KEY_COUNT] = {
+    "revision", "temperature", "voltage", "connect_status",
+    "SIM Status", "sim_status", "ISP", "CQI UL", "CQI DL", "AMBR UL", "AMBR DL", "network_mode",
+    "MMC", "MCC", "MNC",
+};
+
+enum item_field
+{
+    ITEM_KEY,
+    ITEM_VALUE,
+    ITEM_TYPE,
+    ITEM_CLASS,
+    ITEM_MIN_VALUE,
+    ITEM_MAX_VALUE,
+    ITEM_UNIT,
+    ITEM_FIELD_COUNT,
+};
+
+static const char *const item_field_names[ITEM_FIELD_COUNT] = {
+    "key", "value", "type", "class", "min_value", "max_value", "unit",
+};
+
+static const struct
+{
+    const char *plmn;
+    const char *name;
+} isp_names[] = {
+    {"46000", "中国移动"},
+    {"46002", "中国移动"},
+    {"46007", "中国移动"},
+    {"46001", "中国联通"},
+    {"46006", "中国联通"},
+    {"46009", "中国联通"},
+    {"46003", "中国电信"},
+    {"46005", "中国电信"},
+    {"46011", "中国电信"},
+    {"46015", "中国广电"},
+    {"46020", "中国铁通"},
+};
+
+struct modem_progress
+{
+    char name[DEFAULT_VALUE_SIZE];
+    char value[DEFAULT_VALUE_SIZE];
+    char min_value[DEFAULT_VALUE_SIZE];
+    char max_value[DEFAULT_VALUE_SIZE];
+    char unit[DEFAULT_VALUE_SIZE];
+};
+
+/*
+ * Reduction state while walking the reply. Only info[0].modem_info[*] items
+ * are of interest; `matched` counts how many levels of the currently open
+ * containers lie on that path (root, info, info[0], modem_info, item).
+ */
+struct info_reducer
+{
+    int depth;
+    int matched;
+    char kinds[JSON_MAX_DEPTH + 1];
+    int next_index[JSON_MAX_DEPTH + 1];
+    const char *key;
+    bool info_valid;
+    int item_count;
+
+    bool item_has[ITEM_FIELD_COUNT];
+    char item[ITEM_FIELD_COUNT][DEFAULT_VALUE_SIZE];
+
+    bool has[MODEM_KEY_COUNT];
+    char values[MODEM_KEY_COUNT][DEFAULT_VALUE_SIZE];
+    int progress_count;
+    struct modem_progress progress[MODEM_PROGRESS_SLOTS];
+};
+
+// a running `modem_ctrl call info`, its stdout collected into output_buf
+static pid_t ctrl_pid = -1;
+static int ctrl_fd = -1;
+static int ctrl_pidfd = -1; // after EOF, while modem_ctrl has yet to exit
+static int ctrl_deadline_fd = -1;
+static char *output_buf = NULL;
+static size_t output_cap = 0;
+static size_t output_len = 0;
+
+static void reset_modem_metrics(struct modem_metrics *m, const char *text)
+{
+    strcpy(m->revision, text);
+    strcpy(m->temperature, text);
+    strcpy(m->voltage, text);
+    strcpy(m->connect, text);
+    strcpy(m->sim, text);
+    strcpy(m->isp, text);
+    strcpy(m->cqi, text);
+    strcpy(m->ambr, text);
+    strcpy(m->networkmode, text);
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        strcpy(m->signal[i].name, text);
+        m->signal[i].value = 0;
+        m->signal[i].min = 0;
+        m->signal[i].max = 0;
+        strcpy(m->signal[i].unit, text);
+    }
+}
+
+static void copy_value(char *dst, const char *src, size_t len)
+{
+    if (len >= DEFAULT_VALUE_SIZE)
+    {
+        len = DEFAULT_VALUE_SIZE - 1;
+    }
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+/* Python's str(): literals are spelled the Python way */
+static void copy_python_str(char *dst, enum json_event ev, const char *str, size_t len)
+{
+    switch (ev)
+    {
+    case JSON_TRUE:
+        copy_value(dst, "True", 4);
+        break;
+    case JSON_FALSE:
+        copy_value(dst, "False", 5);
+        break;
+    case JSON_NULL:
+        copy_value(dst, "None", 4);
+        break;
+    default:
+        copy_value(dst, str, len);
+        break;
+    }
+}
+
+static void copy_stripped(char *dst, const char *src)
+{
+    const char *end = src + strlen(src);
+    while (*src == ' ' || *src == '\t' || *src == '\n' || *src == '\r')
+    {
+        src++;
+    }
+    while (end > src && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r'))
+    {
+        end--;
+    }
+    copy_value(dst, src, (size_t)(end - src));
+}
+
+static void reduce_item(struct info_reducer *r)
+{
+    if (!r->item_has[ITEM_KEY])
+    {
+        return;
+    }
+    const char *key = r->item[ITEM_KEY];
+    for (int k = 0; k < MODEM_KEY_COUNT; k++)
+    {
+        if (strcmp(key, modem_key_names[k]) == 0)
+        {
+            copy_stripped(r->values[k], r->item_has[ITEM_VALUE] ? r->item[ITEM_VALUE] : "");
+            r->has[k] = true;
+            return;
+        }
+    }
+    if (strcmp(r->item[ITEM_TYPE], "progress_bar") != 0 || strcmp(r->item[ITEM_CLASS], "Cell Information") != 0)
+    {
+        return;
+    }
+
+    char name[DEFAULT_VALUE_SIZE];
+    size_t n = 0;
+    for (const char *p = key; *p != '\0'; p++)
+    {
+        if (*p != ' ')
+        {
+            name[n++] = *p;
+        }
+    }
+    name[n] = '\0';
+
+    // later duplicates overwrite the values but keep their first position
+    int slot;
+    for (slot = 0; slot < r->progress_count; slot++)
+    {
+        if (strcmp(r->progress[slot].name, name) == 0)
+        {
+            break;
+        }
+    }
+    if (slot == r->progress_count)
+    {
+        if (r->progress_count >= MODEM_PROGRESS_SLOTS)
+        {
+            return;
+        }
+        r->progress_count++;
+    }
+    struct modem_progress *p = &r->progress[slot];
+    strcpy(p->name, name);
+    strcpy(p->value, r->item[ITEM_VALUE]);
+    strcpy(p->min_value, r->item[ITEM_MIN_VALUE]);
+    strcpy(p->max_value, r->item[ITEM_MAX_VALUE]);
+    strcpy(p->unit, r->item[ITEM_UNIT]);
+}
+
+/* Handles the start of any value (scalar or container) at the current depth */
+static void reducer_value(struct info_reducer *r, enum json_event ev, const char *str, size_t len)
+{
+    int d = r->depth;
+    bool is_object = ev == JSON_OBJECT_BEGIN;
+    bool is_array = ev == JSON_ARRAY_BEGIN;
+    int index = -1;
+
+    if (d > 0 && r->kinds[d] == '[')
+    {
+        index = r->next_index[d]++;
+    }
+
+    if (r->matched == d)
+    {
+        switch (d)
+        {
+        case 0:
+            r->matched += is_object;
+            break;
+        case 1:
+            r->matched += is_array && strcmp(r->key, "info") == 0;
+            break;
+        case 2:
+            r->matched += is_object && index == 0;
+            break;
+        case 3:
+            if (is_array && strcmp(r->key, "modem_info") == 0)
+            {
+                r->matched++;
+                r->info_valid = true;
+            }
+            break;
+        case 4:
+            if (is_object)
+            {
+                r->matched++;
+                r->item_count++;
+                memset(r->item_has, 0, sizeof(r->item_has));
+                memset(r->item, 0, sizeof(r->item));
+            }
+            break;
+        case 5:
+            for (int f = 0; f < ITEM_FIELD_COUNT && !is_object && !is_array; f++)
+            {
+                if (strcmp(r->key, item_field_names[f]) == 0)
+                {
+                    copy_python_str(r->item[f], ev, str, len);
+                    r->item_has[f] = true;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    if (is_object || is_array)
+    {
+        r->depth++;
+        r->kinds[r->depth] = is_object ? '{' : '[';
+        r->next_index[r->depth] = 0;
+    }
+}
+
+static int reducer_cb(enum json_event ev, const char *str, size_t len, void *arg)
+{
+    struct info_reducer *r = arg;
+
+    switch (ev)
+    {
+    case JSON_KEY:
+        r->key = str;
+        return 0;
+    case JSON_OBJECT_END:
+    case JSON_ARRAY_END:
+        if (r->matched == 5 && r->depth == 5)
+        {
+            reduce_item(r);
+        }
+        r->depth--;
+        if (r->matched > r->depth)
+        {
+            r->matched = r->depth;
+        }
+        return 0;
+    default:
+        reducer_value(r, ev, str, len);
+        return 0;
+    }
+}
+
+static const char *value_or(const struct info_reducer *r, enum modem_key k, const char *dflt)
+{
+    return r->has[k] ? r->values[k] : dflt;
+}
+
+/* An empty value never made it through the old key:value transport */
+static void set_text(char *dst, const char *value)
+{
+    if (value[0] != '\0')
+    {
+        copy_value(dst, value, strlen(value));
+    }
+}
+
+static void merge_pair(char *dst, const struct info_reducer *r, enum modem_key first, enum modem_key second,
+                       const char *fmt, const char *unknown)
+{
+    const char *a = value_or(r, first, "");
+    const char *b = value_or(r, second, "");
+    if (a[0] == '\0')
+    {
+        a = "-";
+    }
+    if (b[0] == '\0')
+    {
+        b = "-";
+    }
+    if (strcmp(a, "-") == 0 && strcmp(b, "-") == 0)
+    {
+        set_text(dst, unknown);
+    }
+    else
+    {
+        char buf[DEFAULT_VALUE_SIZE];
+        snprintf(buf, sizeof(buf), fmt, a, b);
+        set_text(dst, buf);
+    }
+}
+
+static void apply_reduction(const struct info_reducer *r, struct modem_metrics *m)
+{
+    const char *unknown = "-";
+    const char *sim_status = value_or(r, MODEM_KEY_SIM_STATUS, value_or(r, MODEM_KEY_SIM_STATUS_LOWER, "unknown"));
+    if (strcmp(sim_status, "miss") == 0)
+    {
+        unknown = "无SIM卡";
+    }
+
+    char network_mode[DEFAULT_VALUE_SIZE];
+    strcpy(network_mode, value_or(r, MODEM_KEY_NETWORK_MODE, unknown));
+    size_t mode_len = strlen(network_mode);
+    if (r->has[MODEM_KEY_NETWORK_MODE] && mode_len >= 5 && strcmp(network_mode + mode_len - 5, " Mode") == 0)
+    {
+        network_mode[mode_len - 5] = '\0';
+    }
+
+    char isp[DEFAULT_VALUE_SIZE];
+    strcpy(isp, value_or(r, MODEM_KEY_ISP, "????"));
+    if (strcmp(isp, "????") == 0)
+    {
+        snprintf(isp, sizeof(isp), "%s%s",
+                 value_or(r, MODEM_KEY_MMC, value_or(r, MODEM_KEY_MCC, "")),
+                 value_or(r, MODEM_KEY_MNC, unknown));
+        for (size_t i = 0; i < sizeof(isp_names) / sizeof(isp_names[0]); i++)
+        {
+            if (strcmp(isp, isp_names[i].plmn) == 0)
+            {
+                strcpy(isp, isp_names[i].name);
+                break;
+            }
+        }
+    }
+
+    set_text(m->revision, value_or(r, MODEM_KEY_REVISION, "unknown"));
+    set_text(m->temperature, value_or(r, MODEM_KEY_TEMPERATURE, "unknown"));
+    set_text(m->voltage, value_or(r, MODEM_KEY_VOLTAGE, "unknown"));
+    set_text(m->connect, value_or(r, MODEM_KEY_CONNECT_STATUS, unknown));
+    set_text(m->sim, sim_status);
+    set_text(m->isp, isp);
+    merge_pair(m->cqi, r, MODEM_KEY_CQI_DL, MODEM_KEY_CQI_UL, "DL %s UL %s", unknown);
+    merge_pair(m->ambr, r, MODEM_KEY_AMBR_DL, MODEM_KEY_AMBR_UL, "%s/%s", unknown);
+    set_text(m->networkmode, network_mode);
+
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        struct modem_signal *s = &m->signal[i];
+        if (i < r->progress_count)
+        {
+            const struct modem_progress *p = &r->progress[i];
+            char unit[DEFAULT_VALUE_SIZE * 3];
+            set_text(s->name, p->name);
+            s->value = atoi(p->value);
+            s->min = atoi(p->min_value);
+            s->max = atoi(p->max_value);
+            snprintf(unit, sizeof(unit), "%s/%s%s", p->value, p->max_value, p->unit);
+            set_text(s->unit, unit);
+        }
+        else
+        {
+            set_text(s->name, "-");
+            s->value = 0;
+            s->min = 0;
+            s->max = 0;
+            set_text(s->unit, "-");
+        }
+    }
+}
+
+int modem_parse_info_json(char *buf, size_t len, struct modem_metrics *m)
+{
+    static struct info_reducer r;
+
+    memset(&r, 0, sizeof(r));
+    if (json_parse(buf, len, reducer_cb, &r) != 0 || !r.info_valid || r.item_count == 0)
+    {
+        return -1;
+    }
+    apply_reduction(&r, m);
+    return 0;
+}
+
+static int ctrl_start(void)
+{
+    char *const argv[] = {MODEM_CTRL_PATH, "call", "info", NULL};
+
+    if (ctrl_deadline_fd < 0 && (ctrl_deadline_fd = event_loop_create_timer()) < 0)
+    {
+        return -1;
+    }
+    ctrl_pid = subprocess_spawn(argv, 0, &ctrl_fd);
+    if (ctrl_pid < 0)
+    {
+        return -1;
+    }
+    output_len = 0;
+    event_loop_set_timer(ctrl_deadline_fd, MODEM_CTRL_TIMEOUT_MS, 0);
+    return 0;
+}
+
+/* Closes our fds once the child has been reaped or killed */
+static void ctrl_finish(void)
+{
+    if (ctrl_fd >= 0)
+    {
+        close(ctrl_fd);
+        ctrl_fd = -1;
+    }
+    if (ctrl_pidfd >= 0)
+    {
+        close(ctrl_pidfd);
+        ctrl_pidfd = -1;
+    }
+    event_loop_stop_timer(ctrl_deadline_fd);
+    ctrl_pid = -1;
+}
+
+/*
+ * Returns 1 once modem_ctrl has finished or was killed, 0 while it runs.
+ * Nothing here blocks: after EOF the child is reaped when its pidfd becomes
+ * readable, or at the latest when the deadline fires.
+ */
+static int ctrl_handle_event(struct modem_metrics *m)
+{
+    enum subprocess_status status;
+
+    if (ctrl_pid < 0)
+    {
+        return 0;
+    }
+    bool timed_out = event_loop_timer_fired(ctrl_deadline_fd);
+    if (ctrl_fd >= 0 && !timed_out)
+    {
+        int ret = subprocess_read(ctrl_fd, &output_buf, &output_cap, &output_len);
+        if (ret == 0)
+        {
+            return 0;
+        }
+        if (ret < 0)
+        {
+            subprocess_kill(ctrl_pid);
+            ctrl_finish();
+            reset_modem_metrics(m, UNKNOWN_VALUE_REPLACE_STRING);
+            return -1;
+        }
+        // opened before closing the pipe so the collector sees a new fd number
+        ctrl_pidfd = subprocess_pidfd(ctrl_pid);
+        close(ctrl_fd);
+        ctrl_fd = -1;
+    }
+
+    if (ctrl_fd < 0 && subprocess_reap(ctrl_pid, &status))
+    {
+        ctrl_finish();
+        reset_modem_metrics(m, UNKNOWN_VALUE_REPLACE_STRING);
+        if (status == SUBPROCESS_OK && output_len > 0 && modem_parse_info_json(output_buf, output_len, m) == 0)
+        {
+            return 1;
+        }
+        return -1;
+    }
+    if (!timed_out)
+    {
+        return 0;
+    }
+    fprintf(stderr, "%s: no answer after %d ms, killed\n", MODEM_CTRL_PATH, MODEM_CTRL_TIMEOUT_MS);
+    subprocess_kill(ctrl_pid);
+    ctrl_finish();
+    reset_modem_metrics(m, STALE_VALUE_REPLACE_STRING);
+    return -1;
+}
+
+static bool use_script_backend(void)
+{
+    static int use_script = -1;
+    if (use_script < 0)
+    {
+        const char *backend = getenv("ZZ_MODEM_BACKEND");
+        use_script = backend != NULL && strcmp(backend, "python") == 0;
+    }
+    return use_script;
+}
+
+int modem_event_fd(void)
+{
+    if (use_script_backend())
+    {
+        return modem_worker_fd();
+    }
+    return ctrl_fd >= 0 ? ctrl_fd : ctrl_pidfd;
+}
+
+int modem_deadline_fd(void)
+{
+    return use_script_backend() ? modem_worker_deadline_fd() : ctrl_deadline_fd;
+}
+
+int modem_handle_event(struct modem_metrics *m)
+{
+    const uint8_t *body;
+    size_t len;
+
+    if (!use_script_backend())
+    {
+        return ctrl_handle_event(m);
+    }
+    if (modem_worker_timed_out())
+    {
+        fprintf(stderr, "modem worker: no reply after %d ms, restarting it\n", MODEM_WORKER_TIMEOUT_MS);
+        modem_worker_stop();
+        reset_modem_metrics(m, STALE_VALUE_REPLACE_STRING);
+        return -1;
+    }
+    int ret = modem_worker_read(&body, &len);
+    if (ret == 0)
+    {
+        return 0;
+    }
+    reset_modem_metrics(m, UNKNOWN_VALUE_REPLACE_STRING);
+    if (ret < 0)
+    {
+        return -1;
+    }
+    if (modem_record_decode(body, len, m) != 0)
+    {
+        fprintf(stderr, "modem worker: truncated record\n");
+        return -1;
+    }
+    // an empty frame means modem_info.py got no answer from modem_ctrl
+    return len > 0 ? 1 : -1;
+}
+
+int modem_collect(struct modem_metrics *m)
+{
+    // replies and deadlines arrive through modem_handle_event(); keep showing the last values
+    if (use_script_backend())
+    {
+        if (!modem_worker_busy() && modem_worker_request() != 0)
+        {
+            reset_modem_metrics(m, UNKNOWN_VALUE_REPLACE_STRING);
+            return -1;
+        }
+        return 0;
+    }
+    if (ctrl_pid < 0 && ctrl_start() != 0)
+    {
+        reset_modem_metrics(m, UNKNOWN_VALUE_REPLACE_STRING);
+        return -1;
+    }
+    return 0;
+}
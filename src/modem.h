@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_MODEM_H
+#define _XGP_V3_MODEM_H
+
+#include "metrics.h"
+#include <stddef.h>
+
+/*
+ * Modem information for the ModemInfo / ModemSignal screens.
+ *
+ * The native client runs `modem_ctrl call info` itself and reduces its JSON
+ * with the same rules as modem_info.py (key selection, MCC/MNC to ISP name,
+ * CQI/AMBR merging, first three Cell Information progress bars). Setting
+ * ZZ_MODEM_BACKEND=python switches to the modem_info.py worker instead. Either
+ * way the reply arrives asynchronously on modem_event_fd(), and
+ * modem_deadline_fd() fires when it is overdue.
+ */
+
+#define MODEM_CTRL_PATH "/usr/libexec/rpcd/modem_ctrl"
+#define MODEM_INFO_SCRIPT_PATH "/usr/zz/modem_info.py"
+#define MODEM_CTRL_TIMEOUT_MS 10000
+
+/*
+ * modem_collect() and modem_handle_event() return 1 when m holds a fresh
+ * reading, -1 when it was reset after a failure (STALE on timeout) and 0
+ * while the reply is pending.
+ */
+
+/* Starts a poll */
+int modem_collect(struct modem_metrics *m);
+
+/* fd to watch for a pending reply (or the exit after it), -1 if there is none */
+int modem_event_fd(void);
+
+/* timerfd to watch next to it, -1 before the first poll */
+int modem_deadline_fd(void);
+
+/* Call when either fd is readable */
+int modem_handle_event(struct modem_metrics *m);
+
+/* Reduces a `modem_ctrl call info` reply; buf is modified. 0 on success */
+int modem_parse_info_json(char *buf, size_t len, struct modem_metrics *m);
+
+#endif
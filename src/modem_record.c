@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "modem_record.h"
+#include <string.h>
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static int32_t get_i32(const uint8_t *p)
+{
+    return (int32_t)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+int modem_record_body_length(const uint8_t *header)
+{
+    if (memcmp(header, MODEM_RECORD_MAGIC, 4) != 0 || header[4] != MODEM_RECORD_VERSION)
+    {
+        return -1;
+    }
+    return get_u16(header + 6);
+}
+
+/* Destination of a string field, NULL if the id does not name one */
+static char *string_field(struct modem_metrics *m, unsigned id)
+{
+    switch (id)
+    {
+    case MODEM_FIELD_REVISION:
+        return m->revision;
+    case MODEM_FIELD_TEMPERATURE:
+        return m->temperature;
+    case MODEM_FIELD_VOLTAGE:
+        return m->voltage;
+    case MODEM_FIELD_CONNECT:
+        return m->connect;
+    case MODEM_FIELD_SIM:
+        return m->sim;
+    case MODEM_FIELD_ISP:
+        return m->isp;
+    case MODEM_FIELD_CQI:
+        return m->cqi;
+    case MODEM_FIELD_AMBR:
+        return m->ambr;
+    case MODEM_FIELD_NETWORKMODE:
+        return m->networkmode;
+    }
+    if (id >= MODEM_FIELD_SIGNAL(0) && id < MODEM_FIELD_SIGNAL(MODEM_SIGNAL_COUNT))
+    {
+        struct modem_signal *s = &m->signal[(id - MODEM_FIELD_SIGNAL_BASE) / 8];
+        switch ((id - MODEM_FIELD_SIGNAL_BASE) % 8)
+        {
+        case MODEM_SIGNAL_NAME:
+            return s->name;
+        case MODEM_SIGNAL_UNIT:
+            return s->unit;
+        }
+    }
+    return NULL;
+}
+
+static int *int_field(struct modem_metrics *m, unsigned id)
+{
+    if (id >= MODEM_FIELD_SIGNAL(0) && id < MODEM_FIELD_SIGNAL(MODEM_SIGNAL_COUNT))
+    {
+        struct modem_signal *s = &m->signal[(id - MODEM_FIELD_SIGNAL_BASE) / 8];
+        switch ((id - MODEM_FIELD_SIGNAL_BASE) % 8)
+        {
+        case MODEM_SIGNAL_VALUE:
+            return &s->value;
+        case MODEM_SIGNAL_MIN:
+            return &s->min;
+        case MODEM_SIGNAL_MAX:
+            return &s->max;
+        }
+    }
+    return NULL;
+}
+
+int modem_record_decode(const uint8_t *body, size_t len, struct modem_metrics *m)
+{
+    const uint8_t *p = body;
+    const uint8_t *end = body + len;
+
+    while (p < end)
+    {
+        if (end - p < 4)
+        {
+            return -1;
+        }
+        unsigned id = p[0];
+        unsigned type = p[1];
+        size_t data_len = get_u16(p + 2);
+        const uint8_t *data = p + 4;
+        if ((size_t)(end - data) < data_len)
+        {
+            return -1;
+        }
+        p = data + data_len;
+
+        if (type == MODEM_RECORD_STRING)
+        {
+            char *dst = string_field(m, id);
+            // empty values stay unknown, as they did with the key:value output
+            if (dst != NULL && data_len > 0)
+            {
+                if (data_len >= DEFAULT_VALUE_SIZE)
+                {
+                    data_len = DEFAULT_VALUE_SIZE - 1;
+                }
+                memcpy(dst, data, data_len);
+                dst[data_len] = '\0';
+            }
+        }
+        else if (type == MODEM_RECORD_INT && data_len == 4)
+        {
+            int *dst = int_field(m, id);
+            if (dst != NULL)
+            {
+                *dst = get_i32(data);
+            }
+        }
+    }
+    return 0;
+}
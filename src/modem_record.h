@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_MODEM_RECORD_H
+#define _XGP_V3_MODEM_RECORD_H
+
+#include "metrics.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Reply format of `modem_info.py --serve`, all integers little-endian:
+ *
+ *   frame:  "XGPM" | u8 version | u8 record count | u16 body length | body
+ *   record: u8 field id | u8 type | u16 length | data
+ *
+ * Strings carry their length and are not terminated, integers are int32.
+ * Unknown field ids and types are skipped, so fields can be added without
+ * bumping the version; change the version only when a layout changes.
+ * Keep in sync with files/modem_info.py.
+ */
+
+#define MODEM_RECORD_MAGIC "XGPM"
+#define MODEM_RECORD_VERSION 1
+#define MODEM_RECORD_HEADER_SIZE 8
+
+enum modem_record_type
+{
+    MODEM_RECORD_INT = 1,
+    MODEM_RECORD_STRING = 2,
+};
+
+enum modem_record_field
+{
+    MODEM_FIELD_REVISION = 1,
+    MODEM_FIELD_TEMPERATURE = 2,
+    MODEM_FIELD_VOLTAGE = 3,
+    MODEM_FIELD_CONNECT = 4,
+    MODEM_FIELD_SIM = 5,
+    MODEM_FIELD_ISP = 6,
+    MODEM_FIELD_CQI = 7,
+    MODEM_FIELD_AMBR = 8,
+    MODEM_FIELD_NETWORKMODE = 9,
+    // signal n uses MODEM_FIELD_SIGNAL(n) + one of the offsets below
+    MODEM_FIELD_SIGNAL_BASE = 0x10,
+};
+
+#define MODEM_FIELD_SIGNAL(n) (MODEM_FIELD_SIGNAL_BASE + (n) * 8)
+
+enum modem_signal_field
+{
+    MODEM_SIGNAL_NAME = 0,
+    MODEM_SIGNAL_VALUE = 1,
+    MODEM_SIGNAL_MIN = 2,
+    MODEM_SIGNAL_MAX = 3,
+    MODEM_SIGNAL_UNIT = 4,
+};
+
+/* Body length from a header, or -1 if the magic or version does not match */
+int modem_record_body_length(const uint8_t *header);
+
+/* Decodes a frame body into m; 0 on success, -1 on a truncated record */
+int modem_record_decode(const uint8_t *body, size_t len, struct modem_metrics *m);
+
+#endif
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "modem_worker.h"
+#include "event_loop.h"
+#include "modem.h"
+#include "modem_record.h"
+#include "subprocess.h"
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+
+static pid_t worker_pid = -1;
+static int worker_fd = -1;
+static int worker_busy = 0;
+
+static uint8_t frame_buf[MODEM_WORKER_FRAME_MAX];
+static size_t frame_len = 0;
+static size_t frame_consumed = 0; // bytes of the previous reply still at the front
+
+static int deadline_fd = -1; // armed while a request is waiting for its reply
+
+void modem_worker_stop(void)
+{
+    if (worker_fd >= 0)
+    {
+        close(worker_fd);
+        worker_fd = -1;
+    }
+    if (worker_pid > 0)
+    {
+        subprocess_kill(worker_pid);
+        worker_pid = -1;
+    }
+    if (deadline_fd >= 0)
+    {
+        event_loop_stop_timer(deadline_fd);
+    }
+    worker_busy = 0;
+    frame_len = 0;
+    frame_consumed = 0;
+}
+
+static int worker_start(void)
+{
+    char *const argv[] = {"/usr/bin/python3", MODEM_INFO_SCRIPT_PATH, "--serve", NULL};
+
+    // stderr stays connected so Python tracebacks end up in the log
+    worker_pid = subprocess_spawn(argv, SUBPROCESS_DUPLEX, &worker_fd);
+    return worker_pid < 0 ? -1 : 0;
+}
+
+int modem_worker_request(void)
+{
+    static const char request[] = "info\n";
+
+    if (worker_busy)
+    {
+        return -1;
+    }
+    if (deadline_fd < 0 && (deadline_fd = event_loop_create_timer()) < 0)
+    {
+        return -1;
+    }
+    if (worker_fd < 0 && worker_start() != 0)
+    {
+        return -1;
+    }
+    // MSG_NOSIGNAL: a worker that died must not take us down with SIGPIPE
+    if (send(worker_fd, request, sizeof(request) - 1, MSG_NOSIGNAL) != (ssize_t)(sizeof(request) - 1))
+    {
+        modem_worker_stop();
+        return -1;
+    }
+    worker_busy = 1;
+    event_loop_set_timer(deadline_fd, MODEM_WORKER_TIMEOUT_MS, 0);
+    return 0;
+}
+
+int modem_worker_busy(void)
+{
+    return worker_busy;
+}
+
+int modem_worker_deadline_fd(void)
+{
+    return deadline_fd;
+}
+
+int modem_worker_timed_out(void)
+{
+    return event_loop_timer_fired(deadline_fd) && worker_busy;
+}
+
+int modem_worker_fd(void)
+{
+    return worker_fd;
+}
+
+int modem_worker_read(const uint8_t **body, size_t *len)
+{
+    if (worker_fd < 0)
+    {
+        return -1;
+    }
+
+    if (frame_consumed > 0)
+    {
+        memmove(frame_buf, frame_buf + frame_consumed, frame_len - frame_consumed);
+        frame_len -= frame_consumed;
+        frame_consumed = 0;
+    }
+
+    while (1)
+    {
+        if (frame_len >= MODEM_RECORD_HEADER_SIZE)
+        {
+            int body_len = modem_record_body_length(frame_buf);
+            if (body_len < 0 || MODEM_RECORD_HEADER_SIZE + (size_t)body_len > sizeof(frame_buf))
+            {
+                fprintf(stderr, "modem worker: unexpected reply, restarting it\n");
+                modem_worker_stop();
+                return -1;
+            }
+            if (frame_len >= MODEM_RECORD_HEADER_SIZE + (size_t)body_len)
+            {
+                *body = frame_buf + MODEM_RECORD_HEADER_SIZE;
+                *len = (size_t)body_len;
+                frame_consumed = MODEM_RECORD_HEADER_SIZE + (size_t)body_len;
+                worker_busy = 0;
+                event_loop_stop_timer(deadline_fd);
+                return 1;
+            }
+        }
+
+        ssize_t n = read(worker_fd, frame_buf + frame_len, sizeof(frame_buf) - frame_len);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return 0;
+        }
+        if (n <= 0)
+        {
+            modem_worker_stop();
+            return -1;
+        }
+        frame_len += (size_t)n;
+    }
+}
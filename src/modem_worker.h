@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_MODEM_WORKER_H
+#define _XGP_V3_MODEM_WORKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * `modem_info.py --serve` kept running as a co-process, connected through a
+ * socketpair. A poll is one "info\n" request answered by one record frame
+ * (see modem_record.h), so the interpreter starts once instead of on every
+ * poll.
+ */
+
+#define MODEM_WORKER_FRAME_MAX 8192
+#define MODEM_WORKER_TIMEOUT_MS 20000
+
+/* Starts the worker if needed and sends a request; 0 on success */
+int modem_worker_request(void);
+
+/* True while a request is waiting for its reply */
+int modem_worker_busy(void);
+
+/*
+ * timerfd armed with MODEM_WORKER_TIMEOUT_MS when a request is sent and
+ * stopped by its reply; -1 before the first request. Watch it for
+ * readability next to modem_worker_fd().
+ */
+int modem_worker_deadline_fd(void);
+
+/* Consumes the deadline; true if the pending reply is overdue */
+int modem_worker_timed_out(void);
+
+/* Kills the worker; the next request starts a new one */
+void modem_worker_stop(void);
+
+/* Socket to watch for readability, -1 if the worker is not running */
+int modem_worker_fd(void);
+
+/*
+ * Reads whatever is available without blocking. Returns 1 and sets *body
+ * (the frame body, valid until the next call) when a reply is complete, 0 if
+ * more data is needed, -1 if the worker went away or spoke another protocol
+ * version; it is restarted by the next request.
+ */
+int modem_worker_read(const uint8_t **body, size_t *len);
+
+#endif
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "neigh.h"
+#include "netlink.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <linux/rtnetlink.h>
+#include <linux/neighbour.h>
+
+#define NEIGH_TABLE_INITIAL_SIZE 256
+
+// NUD_VALID from include/net/neighbour.h, not exported to userspace
+#define NEIGH_NUD_VALID (NUD_PERMANENT | NUD_NOARP | NUD_REACHABLE | NUD_PROBE | NUD_STALE | NUD_DELAY)
+
+struct neigh_entry
+{
+    uint32_t addr; // 0 marks an empty slot
+    int ifindex;
+    bool online;
+};
+
+static struct nl_sock rtnl = {.fd = -1};
+static struct neigh_entry *table = NULL;
+static uint32_t table_size = 0;
+static uint32_t table_used = 0;
+static int online_total = -1;
+static struct neigh_iface_count ifaces[NEIGH_MAX_IFACES];
+static int iface_count = 0;
+
+static uint32_t neigh_hash(uint32_t addr, int ifindex)
+{
+    uint32_t h = addr ^ ((uint32_t)ifindex * 0x9e3779b9u);
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static struct neigh_entry *table_find(uint32_t addr, int ifindex, bool *found)
+{
+    uint32_t mask = table_size - 1;
+    uint32_t i = neigh_hash(addr, ifindex) & mask;
+
+    while (table[i].addr != 0)
+    {
+        if (table[i].addr == addr && table[i].ifindex == ifindex)
+        {
+            *found = true;
+            return &table[i];
+        }
+        i = (i + 1) & mask;
+    }
+    *found = false;
+    return &table[i];
+}
+
+static int table_alloc(uint32_t size)
+{
+    struct neigh_entry *old = table;
+    uint32_t old_size = table_size;
+
+    table = calloc(size, sizeof(*table));
+    if (table == NULL)
+    {
+        table = old;
+        return -1;
+    }
+    table_size = size;
+    for (uint32_t i = 0; i < old_size; i++)
+    {
+        if (old[i].addr != 0)
+        {
+            bool found;
+            *table_find(old[i].addr, old[i].ifindex, &found) = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+/* Backward-shift deletion keeps probe chains intact without tombstones */
+static void table_remove(struct neigh_entry *e)
+{
+    uint32_t mask = table_size - 1;
+    uint32_t hole = (uint32_t)(e - table);
+    uint32_t i = hole;
+
+    while (1)
+    {
+        i = (i + 1) & mask;
+        if (table[i].addr == 0)
+        {
+            break;
+        }
+        uint32_t home = neigh_hash(table[i].addr, table[i].ifindex) & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            table[hole] = table[i];
+            hole = i;
+        }
+    }
+    table[hole].addr = 0;
+    table_used--;
+}
+
+static void iface_adjust(int ifindex, int delta)
+{
+    for (int i = 0; i < iface_count; i++)
+    {
+        if (ifaces[i].ifindex == ifindex)
+        {
+            ifaces[i].online += delta;
+            return;
+        }
+    }
+    if (delta <= 0 || iface_count >= NEIGH_MAX_IFACES)
+    {
+        return;
+    }
+    struct neigh_iface_count *c = &ifaces[iface_count++];
+    c->ifindex = ifindex;
+    c->online = delta;
+    if (if_indextoname(ifindex, c->name) == NULL)
+    {
+        snprintf(c->name, sizeof(c->name), "if%d", ifindex);
+    }
+}
+
+static void set_online(struct neigh_entry *e, bool online)
+{
+    if (e->online == online)
+    {
+        return;
+    }
+    e->online = online;
+    online_total += online ? 1 : -1;
+    iface_adjust(e->ifindex, online ? 1 : -1);
+}
+
+static bool state_is_online(uint16_t state)
+{
+    return (state & NEIGH_NUD_VALID) && !(state & (NUD_NOARP | NUD_PERMANENT));
+}
+
+static void handle_neigh_msg(const struct nlmsghdr *nlh, void *arg)
+{
+    (void)arg;
+    const struct ndmsg *ndm = NLMSG_DATA(nlh);
+    const struct nlattr *tb[NDA_MAX + 1];
+
+    if ((nlh->nlmsg_type != RTM_NEWNEIGH && nlh->nlmsg_type != RTM_DELNEIGH) ||
+        nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ndm)) ||
+        ndm->ndm_family != AF_INET || (ndm->ndm_flags & NTF_PROXY))
+    {
+        return;
+    }
+
+    nl_parse_attrs((const char *)ndm + NLMSG_ALIGN(sizeof(*ndm)),
+                   nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*ndm)), tb, NDA_MAX);
+    if (tb[NDA_DST] == NULL || nl_attr_len(tb[NDA_DST]) != 4)
+    {
+        return;
+    }
+    uint32_t addr;
+    memcpy(&addr, nl_attr_data(tb[NDA_DST]), sizeof(addr));
+    if (addr == 0)
+    {
+        return;
+    }
+
+    bool found;
+    struct neigh_entry *e = table_find(addr, ndm->ndm_ifindex, &found);
+    if (nlh->nlmsg_type == RTM_DELNEIGH)
+    {
+        if (found)
+        {
+            set_online(e, false);
+            table_remove(e);
+        }
+        return;
+    }
+
+    if (!found)
+    {
+        if ((table_used + 1) * 2 > table_size)
+        {
+            if (table_alloc(table_size * 2) != 0)
+            {
+                return;
+            }
+            e = table_find(addr, ndm->ndm_ifindex, &found);
+        }
+        e->addr = addr;
+        e->ifindex = ndm->ndm_ifindex;
+        e->online = false;
+        table_used++;
+    }
+    set_online(e, state_is_online(ndm->ndm_state));
+}
+
+static int neigh_dump(void)
+{
+    struct
+    {
+        struct nlmsghdr nlh;
+        struct ndmsg ndm;
+    } req;
+
+    memset(table, 0, table_size * sizeof(*table));
+    table_used = 0;
+    online_total = 0;
+    iface_count = 0;
+
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(req.ndm));
+    req.nlh.nlmsg_type = RTM_GETNEIGH;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.ndm.ndm_family = AF_INET;
+
+    int seq = nl_send(&rtnl, &req.nlh);
+    if (seq < 0)
+    {
+        return -1;
+    }
+    return nl_recv_reply(&rtnl, (uint32_t)seq, handle_neigh_msg, NULL);
+}
+
+int neigh_init(void)
+{
+    if (table_alloc(NEIGH_TABLE_INITIAL_SIZE) != 0)
+    {
+        return -1;
+    }
+    if (nl_open(&rtnl, NETLINK_ROUTE, 1 << (RTNLGRP_NEIGH - 1)) != 0)
+    {
+        return -1;
+    }
+
+    int ret;
+    while ((ret = neigh_dump()) == -EINTR || ret == -EBUSY || ret == -ENOBUFS)
+    {
+        // the table changed while being dumped, start over
+    }
+    if (ret < 0)
+    {
+        fprintf(stderr, "Warning: neighbour dump failed: %s\n", strerror(-ret));
+        nl_close(&rtnl);
+        online_total = -1;
+        return -1;
+    }
+    return 0;
+}
+
+void neigh_poll(void)
+{
+    if (rtnl.fd < 0)
+    {
+        return;
+    }
+    if (nl_recv_pending(&rtnl, handle_neigh_msg, NULL) == -ENOBUFS)
+    {
+        // socket overrun, events were dropped: rebuild from a fresh dump
+        while (neigh_dump() == -ENOBUFS)
+        {
+        }
+    }
+}
+
+int neigh_fd(void)
+{
+    return rtnl.fd;
+}
+
+int neigh_online_count(void)
+{
+    return online_total;
+}
+
+int neigh_iface_counts(struct neigh_iface_count *out, int max)
+{
+    int n = 0;
+    for (int i = 0; i < iface_count && n < max; i++)
+    {
+        if (ifaces[i].online > 0)
+        {
+            out[n++] = ifaces[i];
+        }
+    }
+    return n;
+}
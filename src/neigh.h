@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_NEIGH_H
+#define _XGP_V3_NEIGH_H
+
+#include <net/if.h>
+
+/*
+ * IPv4 neighbour (ARP) table mirror.
+ *
+ * neigh_init() dumps RTM_GETNEIGH once and subscribes to RTNLGRP_NEIGH;
+ * neigh_poll() then applies RTM_NEWNEIGH/RTM_DELNEIGH events and keeps the
+ * online counts up to date incrementally. A host counts as online under the
+ * same rule as the "0x2" flags column of /proc/net/arp: a valid, dynamic,
+ * non-proxy entry.
+ */
+
+#define NEIGH_MAX_IFACES 16
+
+struct neigh_iface_count
+{
+    int ifindex;
+    char name[IF_NAMESIZE];
+    int online;
+};
+
+int neigh_init(void);
+void neigh_poll(void);
+int neigh_fd(void);
+
+/* Returns -1 until neigh_init() has succeeded */
+int neigh_online_count(void);
+
+/* Copies the per-interface counts of interfaces with online hosts */
+int neigh_iface_counts(struct neigh_iface_count *out, int max);
+
+#endif
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "netlink.h"
+#include <unistd.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+
+int nl_open(struct nl_sock *nl, int protocol, uint32_t groups)
+{
+    struct sockaddr_nl addr;
+
+    nl->fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, protocol);
+    if (nl->fd < 0)
+    {
+        perror("netlink socket");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = groups;
+    if (bind(nl->fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("netlink bind");
+        close(nl->fd);
+        nl->fd = -1;
+        return -1;
+    }
+
+    nl->seq = (uint32_t)time(NULL);
+    return 0;
+}
+
+void nl_close(struct nl_sock *nl)
+{
+    if (nl->fd >= 0)
+    {
+        close(nl->fd);
+        nl->fd = -1;
+    }
+}
+
+int nl_send(struct nl_sock *nl, struct nlmsghdr *nlh)
+{
+    struct sockaddr_nl kernel;
+
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+    nlh->nlmsg_seq = ++nl->seq;
+    if (sendto(nl->fd, nlh, nlh->nlmsg_len, 0, (struct sockaddr *)&kernel, sizeof(kernel)) < 0)
+    {
+        return -1;
+    }
+    return (int)nlh->nlmsg_seq;
+}
+
+/* Returns 1 when the reply to `seq` is complete, 0 to keep reading, <0 on error */
+static int nl_dispatch(const char *buf, int len, uint32_t seq, nl_msg_cb cb, void *arg)
+{
+    const struct nlmsghdr *nlh;
+    int done = 0;
+
+    for (nlh = (const struct nlmsghdr *)buf; NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len))
+    {
+        bool is_reply = seq != 0 && nlh->nlmsg_seq == seq;
+
+        if (nlh->nlmsg_type == NLMSG_DONE)
+        {
+            if (is_reply)
+            {
+                done = 1;
+            }
+            continue;
+        }
+        if (nlh->nlmsg_type == NLMSG_ERROR)
+        {
+            const struct nlmsgerr *err = NLMSG_DATA(nlh);
+            if (is_reply)
+            {
+                return err->error < 0 ? err->error : 1;
+            }
+            continue;
+        }
+        if (nlh->nlmsg_type == NLMSG_NOOP || nlh->nlmsg_type == NLMSG_OVERRUN)
+        {
+            continue;
+        }
+
+        cb(nlh, arg);
+        if (is_reply && !(nlh->nlmsg_flags & NLM_F_MULTI))
+        {
+            done = 1;
+        }
+    }
+
+    return done;
+}
+
+int nl_recv_reply(struct nl_sock *nl, uint32_t seq, nl_msg_cb cb, void *arg)
+{
+    static char buf[NL_RECV_BUFFER_SIZE] __attribute__((aligned(NLMSG_ALIGNTO)));
+
+    while (1)
+    {
+        ssize_t len = recv(nl->fd, buf, sizeof(buf), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+        int ret = nl_dispatch(buf, (int)len, seq, cb, arg);
+        if (ret != 0)
+        {
+            return ret < 0 ? ret : 0;
+        }
+    }
+}
+
+int nl_recv_pending(struct nl_sock *nl, nl_msg_cb cb, void *arg)
+{
+    static char buf[NL_RECV_BUFFER_SIZE] __attribute__((aligned(NLMSG_ALIGNTO)));
+
+    while (1)
+    {
+        ssize_t len = recv(nl->fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -errno;
+        }
+        nl_dispatch(buf, (int)len, 0, cb, arg);
+    }
+}
+
+void nl_parse_attrs(const void *attrs, int len, const struct nlattr **tb, int max)
+{
+    const struct nlattr *attr = attrs;
+
+    memset(tb, 0, sizeof(*tb) * (max + 1));
+    while (len >= NLA_HDRLEN && attr->nla_len >= NLA_HDRLEN && attr->nla_len <= len)
+    {
+        int type = attr->nla_type & NLA_TYPE_MASK;
+        if (type <= max)
+        {
+            tb[type] = attr;
+        }
+        len -= NLA_ALIGN(attr->nla_len);
+        attr = (const struct nlattr *)((const char *)attr + NLA_ALIGN(attr->nla_len));
+    }
+}
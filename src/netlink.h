@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_NETLINK_H
+#define _XGP_V3_NETLINK_H
+
+#include <stdint.h>
+#include <linux/netlink.h>
+
+/*
+ * Minimal netlink plumbing shared by the rtnetlink/ctnetlink collectors.
+ * Attributes of rtnetlink (struct rtattr) and nfnetlink (struct nlattr)
+ * have the same layout, so one parser serves both.
+ */
+
+#define NL_RECV_BUFFER_SIZE 32768
+
+struct nl_sock
+{
+    int fd;
+    uint32_t seq;
+};
+
+typedef void (*nl_msg_cb)(const struct nlmsghdr *nlh, void *arg);
+
+int nl_open(struct nl_sock *nl, int protocol, uint32_t groups);
+void nl_close(struct nl_sock *nl);
+
+/* Fills in nlmsg_seq and sends; returns the sequence number or -1 */
+int nl_send(struct nl_sock *nl, struct nlmsghdr *nlh);
+
+/*
+ * Reads replies to request `seq` until NLMSG_DONE / the final ACK. Multicast
+ * notifications arriving in between are passed to cb as well.
+ * Returns 0, or a negative errno (-ENOBUFS means events were lost).
+ */
+int nl_recv_reply(struct nl_sock *nl, uint32_t seq, nl_msg_cb cb, void *arg);
+
+/* Processes everything queued on the socket without blocking */
+int nl_recv_pending(struct nl_sock *nl, nl_msg_cb cb, void *arg);
+
+void nl_parse_attrs(const void *attrs, int len, const struct nlattr **tb, int max);
+
+static inline const void *nl_attr_data(const struct nlattr *attr)
+{
+    return (const char *)attr + NLA_HDRLEN;
+}
+
+static inline int nl_attr_len(const struct nlattr *attr)
+{
+    return attr->nla_len - NLA_HDRLEN;
+}
+
+#endif
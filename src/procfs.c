@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "procfs.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+
+int procfs_read(struct procfs_file *f)
+{
+    if (f->fd < 0)
+    {
+        f->fd = open(f->path, O_RDONLY | O_CLOEXEC);
+        if (f->fd < 0)
+        {
+            f->len = 0;
+            f->buf[0] = '\0';
+            return -1;
+        }
+    }
+
+    ssize_t len;
+    do
+    {
+        len = pread(f->fd, f->buf, sizeof(f->buf) - 1, 0);
+    } while (len < 0 && errno == EINTR);
+
+    if (len < 0)
+    {
+        len = 0;
+    }
+    f->len = (size_t)len;
+    f->buf[f->len] = '\0';
+    return len > 0 ? (int)len : -1;
+}
+
+const char *procfs_find_line(const char *buf, const char *prefix)
+{
+    size_t prefix_len = strlen(prefix);
+    const char *line = buf;
+
+    while (*line != '\0')
+    {
+        if (strncmp(line, prefix, prefix_len) == 0)
+        {
+            return line;
+        }
+        line = strchr(line, '\n');
+        if (line == NULL)
+        {
+            break;
+        }
+        line++;
+    }
+    return NULL;
+}
+
+static const char *skip_blanks(const char *p)
+{
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    return p;
+}
+
+const char *procfs_parse_u64(const char *p, uint64_t *out)
+{
+    uint64_t v = 0;
+
+    p = skip_blanks(p);
+    if (*p < '0' || *p > '9')
+    {
+        return NULL;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        v = v * 10 + (uint64_t)(*p++ - '0');
+    }
+    *out = v;
+    return p;
+}
+
+const char *procfs_parse_centi(const char *p, uint32_t *out)
+{
+    uint64_t whole;
+    uint32_t frac = 0;
+    int digits = 0;
+
+    p = procfs_parse_u64(p, &whole);
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    if (*p == '.')
+    {
+        // /proc/loadavg prints exactly two digits, anything further is dropped
+        for (p++; *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            if (digits < 2)
+            {
+                frac = frac * 10 + (uint32_t)(*p - '0');
+            }
+        }
+    }
+    if (digits == 1)
+    {
+        frac *= 10;
+    }
+    *out = (uint32_t)whole * 100 + frac;
+    return p;
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_PROCFS_H
+#define _XGP_V3_PROCFS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Kept-open readers for /proc (and other small text files). The file is
+ * opened on first use and re-read with a single pread() from offset 0 into
+ * a fixed buffer, so a sample costs one syscall and no stdio.
+ */
+
+#define PROCFS_BUFFER_SIZE 4096
+
+struct procfs_file
+{
+    const char *path;
+    int fd;
+    size_t len;
+    char buf[PROCFS_BUFFER_SIZE]; // always NUL-terminated after a read
+};
+
+#define PROCFS_FILE_INIT(file_path) {.path = (file_path), .fd = -1}
+
+/*
+ * Refreshes f->buf; returns the number of bytes read or -1. Content beyond
+ * the buffer is cut off, which is fine for the head-of-file fields we use.
+ */
+int procfs_read(struct procfs_file *f);
+
+/* Start of the first line beginning with prefix, or NULL */
+const char *procfs_find_line(const char *buf, const char *prefix);
+
+/* Skips blanks, parses an unsigned decimal. Returns the position after it or NULL */
+const char *procfs_parse_u64(const char *p, uint64_t *out);
+
+/* Same for a decimal in hundredths, e.g. "0.08" -> 8 (extra digits are truncated) */
+const char *procfs_parse_centi(const char *p, uint32_t *out);
+
+#endif
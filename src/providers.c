@@ -0,0 +1,611 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "providers.h"
+#include "conntrack.h"
+#include "cpustat.h"
+#include "ifaddr.h"
+#include "linkstats.h"
+#include "modem.h"
+#include "neigh.h"
+#include "history.h"
+#include "procfs.h"
+#include "thermal.h"
+#include "ui/ui.h"
+#include <unistd.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <sys/sysinfo.h>
+
+#define MAX_ENV_LINE_LENGTH 128
+
+// providers that feed a history channel
+#define LOAD_AVG_PERIOD_MS 1000
+#define MEMORY_PERIOD_MS 1000
+#define ACTIVE_CONNECT_PERIOD_MS 5000
+
+#define MODEM_POLL_MIN_MS 5000
+#define MODEM_POLL_DEFAULT_MS 30000
+#define MODEM_POLL_CEILING_MS 120000 // override with ZZ_MODEM_POLL_MAX (seconds)
+#define MODEM_SIGNAL_DELTA 3         // dB (or whatever unit the channel uses)
+
+void format_memory_size(long bytes, char *buffer)
+{
+    const double MiB = 1024 * 1024;
+    const double GiB = 1024 * 1024 * 1024;
+
+    if (bytes >= GiB)
+    {
+        double gib = bytes / GiB;
+        sprintf(buffer, "%.2fG", gib);
+    }
+    else
+    {
+        double mib = bytes / MiB;
+        sprintf(buffer, "%.2fM", mib);
+    }
+}
+
+bool extract_env_value(const char *line, const char *key, char *value, size_t value_size)
+{
+    size_t key_len = strlen(key);
+    if (strncmp(line, key, key_len) != 0)
+    {
+        return false;
+    }
+
+    const char *equal_sign = strchr(line, '=');
+    if (equal_sign == NULL)
+    {
+        return false;
+    }
+
+    const char *value_start = equal_sign + 1;
+
+    if (*value_start == '"')
+    {
+        value_start++;
+        const char *value_end = strchr(value_start, '"');
+        if (value_end == NULL)
+        {
+            return false;
+        }
+        size_t value_len = value_end - value_start;
+        if (value_len >= value_size)
+        {
+            value_len = value_size - 1;
+        }
+        strncpy(value, value_start, value_len);
+        value[value_len] = '\0';
+    }
+    else if (*value_start == '\'')
+    {
+        value_start++;
+        const char *value_end = strchr(value_start, '\'');
+        if (value_end == NULL)
+        {
+            return false;
+        }
+        size_t value_len = value_end - value_start;
+        if (value_len >= value_size)
+        {
+            value_len = value_size - 1;
+        }
+        strncpy(value, value_start, value_len);
+        value[value_len] = '\0';
+    }
+    else
+    {
+        size_t value_len = strlen(value_start);
+        if (value_len >= value_size)
+        {
+            value_len = value_size - 1;
+        }
+        strncpy(value, value_start, value_len);
+        value[value_len] = '\0';
+    }
+
+    return true;
+}
+
+int read_os_release(char *pretty_name, size_t pretty_name_size,
+                    char *build_id, size_t build_id_size)
+{
+    static struct procfs_file release_file = PROCFS_FILE_INIT("/etc/openwrt_release");
+
+    int ret = procfs_read(&release_file);
+    // the release file never changes at runtime, no need to keep it open
+    close(release_file.fd);
+    release_file.fd = -1;
+    if (ret < 0)
+    {
+        strncpy(pretty_name, UNKNOWN_VALUE_REPLACE_STRING, pretty_name_size);
+        strncpy(build_id, UNKNOWN_VALUE_REPLACE_STRING, build_id_size);
+        return -1;
+    }
+
+    bool found_pretty_name = false;
+    bool found_build_id = false;
+    char line[MAX_ENV_LINE_LENGTH];
+    const char *p = release_file.buf;
+
+    while (*p != '\0' && !(found_pretty_name && found_build_id))
+    {
+        size_t line_len = strcspn(p, "\n");
+        size_t copy_len = line_len < sizeof(line) - 1 ? line_len : sizeof(line) - 1;
+        memcpy(line, p, copy_len);
+        line[copy_len] = '\0';
+        p += line_len;
+        if (*p == '\n')
+        {
+            p++;
+        }
+
+        if (!found_pretty_name)
+        {
+            found_pretty_name = extract_env_value(line, "DISTRIB_DESCRIPTION",
+                                                  pretty_name, pretty_name_size);
+        }
+
+        if (!found_build_id)
+        {
+            found_build_id = extract_env_value(line, "DISTRIB_REVISION",
+                                               build_id, build_id_size);
+        }
+    }
+
+    if (!found_pretty_name)
+    {
+        strncpy(pretty_name, UNKNOWN_VALUE_REPLACE_STRING, pretty_name_size);
+    }
+
+    if (!found_build_id)
+    {
+        strncpy(build_id, UNKNOWN_VALUE_REPLACE_STRING, build_id_size);
+    }
+
+    return 0;
+}
+
+static long memory_total_bytes = 0;
+static char buf_memory_total_bytes[DEFAULT_VALUE_SIZE];
+static char buf_kernel_version[DEFAULT_VALUE_SIZE];
+static char buf_sys_version[DEFAULT_VALUE_SIZE];
+static char buf_build_id[DEFAULT_VALUE_SIZE];
+
+static struct procfs_file loadavg_file = PROCFS_FILE_INIT("/proc/loadavg");
+static struct procfs_file meminfo_file = PROCFS_FILE_INIT("/proc/meminfo");
+
+static void update_static_value(void)
+{
+    struct utsname info;
+    if (uname(&info) == -1)
+    {
+        strcpy(buf_kernel_version, UNKNOWN_VALUE_REPLACE_STRING);
+    }
+    else
+    {
+        strncpy(buf_kernel_version, info.release, DEFAULT_VALUE_SIZE - 1);
+    }
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    memory_total_bytes = pages * page_size;
+    format_memory_size(memory_total_bytes, buf_memory_total_bytes);
+    read_os_release(buf_sys_version, sizeof(buf_sys_version), buf_build_id, sizeof(buf_build_id));
+}
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* period_ms lets the UI tell how many samples were missed while hidden */
+static void take_sample(struct metrics_snapshot *s, enum history_channel ch, int32_t value, uint32_t period_ms)
+{
+    s->samples[ch] = value;
+    s->sample_seq[ch]++;
+    s->sample_ms[ch] = monotonic_ms();
+    s->sample_period_ms[ch] = period_ms;
+}
+
+static void update_hostname(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    if (gethostname(out, DEFAULT_VALUE_SIZE))
+    {
+        strcpy(out, UNKNOWN_VALUE_REPLACE_STRING);
+    }
+}
+
+static void update_sys_version(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    strcpy(out, buf_sys_version);
+}
+
+static void update_build_id(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    strcpy(out, buf_build_id);
+}
+
+static void update_kernel_version(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    strcpy(out, buf_kernel_version);
+}
+
+static void update_load_avg(struct metrics_snapshot *s, char *out)
+{
+    uint32_t avg[3];
+    const char *p = procfs_read(&loadavg_file) > 0 ? loadavg_file.buf : NULL;
+    for (int i = 0; i < 3 && p != NULL; i++)
+    {
+        p = procfs_parse_centi(p, &avg[i]);
+    }
+    if (p == NULL)
+    {
+        strcpy(out, UNKNOWN_VALUE_REPLACE_STRING);
+    }
+    else
+    {
+        snprintf(out, DEFAULT_VALUE_SIZE, "%u.%02u / %u.%02u / %u.%02u",
+                 avg[0] / 100, avg[0] % 100, avg[1] / 100, avg[1] % 100, avg[2] / 100, avg[2] % 100);
+        take_sample(s, HISTORY_LOAD, (int32_t)avg[0], LOAD_AVG_PERIOD_MS);
+    }
+}
+
+static void update_cpu_usage(struct metrics_snapshot *s, char *out)
+{
+    (void)out;
+    int count = cpustat_sample(s->cpu, CPU_CORE_SLOTS);
+    s->cpu_count = count > 0 ? count : 0;
+}
+
+static void update_soc_temp(struct metrics_snapshot *s, char *out)
+{
+    struct thermal_reading r;
+    if (thermal_sample(&r) != 0)
+    {
+        s->soc_temp_mc = INT32_MIN;
+        s->overheat = false;
+        strcpy(out, "SoC " UNKNOWN_VALUE_REPLACE_STRING);
+        return;
+    }
+    int abs_mc = r.temp_mc < 0 ? -r.temp_mc : r.temp_mc;
+    s->soc_temp_mc = r.temp_mc;
+    s->overheat = r.overheat;
+    snprintf(out, DEFAULT_VALUE_SIZE, "%s%s%d.%d℃", r.overheat ? "过热 " : "SoC ", r.temp_mc < 0 ? "-" : "",
+             abs_mc / 1000, abs_mc % 1000 / 100);
+}
+
+static void update_memory(struct metrics_snapshot *s, char *out)
+{
+    if (procfs_read(&meminfo_file) > 0)
+    {
+        unsigned long memory_free_bytes = 0;
+        const char *line = procfs_find_line(meminfo_file.buf, "MemFree:");
+        uint64_t free_kb;
+        if (line != NULL && procfs_parse_u64(line + strlen("MemFree:"), &free_kb) != NULL)
+        {
+            memory_free_bytes = (unsigned long)free_kb * 1024;
+        }
+        unsigned long memory_used_bytes = memory_total_bytes - memory_free_bytes;
+        double usage_percent = (double)memory_used_bytes / memory_total_bytes * 100;
+        char buf_used_str[32];
+        format_memory_size(memory_used_bytes, buf_used_str);
+        snprintf(out, DEFAULT_VALUE_SIZE, "%s / %s (%.0f%%)",
+                 buf_used_str, buf_memory_total_bytes, usage_percent);
+        take_sample(s, HISTORY_MEMORY, (int32_t)(usage_percent * 100), MEMORY_PERIOD_MS);
+    }
+    else
+    {
+        strcpy(out, UNKNOWN_VALUE_REPLACE_STRING);
+    }
+}
+
+static void update_uptime(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    struct sysinfo info;
+    if (sysinfo(&info) == 0)
+    {
+        long uptime = info.uptime;
+        int days = uptime / (24 * 3600);
+        uptime %= (24 * 3600);
+        int hours = uptime / 3600;
+        uptime %= 3600;
+        int minutes = uptime / 60;
+        int seconds = uptime % 60;
+        snprintf(out, DEFAULT_VALUE_SIZE, "%d 天 %d 小时 %d 分 %d 秒",
+                 days, hours, minutes, seconds);
+    }
+    else
+    {
+        strcpy(out, UNKNOWN_VALUE_REPLACE_STRING);
+    }
+}
+
+static void update_local_time(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    time_t raw_time;
+    struct tm time_info;
+    time(&raw_time);
+    localtime_r(&raw_time, &time_info);
+    strftime(out, DEFAULT_VALUE_SIZE, "%Y-%m-%d %H:%M:%S", &time_info);
+}
+
+static void update_modem_ip(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    // 检查是否是wwan接口 (wwan0, wwan1, wwan2等)
+    if (ifaddr_get_first_ipv4("wwan", out, DEFAULT_VALUE_SIZE) != 0)
+    {
+        strcpy(out, UNKNOWN_IP_REPLACE_STRING);
+    }
+}
+
+static void update_wan_ip(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    if (ifaddr_get_ipv4("eth1", out, DEFAULT_VALUE_SIZE) != 0)
+    {
+        strcpy(out, UNKNOWN_IP_REPLACE_STRING);
+    }
+}
+
+static void update_lan_ip(struct metrics_snapshot *s, char *out)
+{
+    (void)s;
+    if (ifaddr_get_ipv4("br-lan", out, DEFAULT_VALUE_SIZE) != 0)
+    {
+        strcpy(out, UNKNOWN_IP_REPLACE_STRING);
+    }
+}
+
+static void update_active_connect(struct metrics_snapshot *s, char *out)
+{
+    int count = conntrack_count();
+    snprintf(out, DEFAULT_VALUE_SIZE, "%d", count);
+    if (count >= 0)
+    {
+        take_sample(s, HISTORY_CONNTRACK, count, ACTIVE_CONNECT_PERIOD_MS);
+    }
+}
+
+static void update_arp_count(struct metrics_snapshot *s, char *out)
+{
+    struct neigh_iface_count arp_ifaces[ARP_IFACE_SLOTS];
+    neigh_poll();
+    snprintf(out, DEFAULT_VALUE_SIZE, "%d", neigh_online_count());
+    s->arp_iface_count = neigh_iface_counts(arp_ifaces, ARP_IFACE_SLOTS);
+    for (int i = 0; i < s->arp_iface_count; i++)
+    {
+        memcpy(s->arp_ifaces[i].name, arp_ifaces[i].name, sizeof(s->arp_ifaces[i].name));
+        s->arp_ifaces[i].online = arp_ifaces[i].online;
+    }
+}
+
+static void format_bit_rate(uint64_t bps, char *buffer, size_t size)
+{
+    if (bps >= 1000 * 1000 * 1000)
+    {
+        snprintf(buffer, size, "%.2f Gbps", bps / 1e9);
+    }
+    else if (bps >= 1000 * 1000)
+    {
+        snprintf(buffer, size, "%.1f Mbps", bps / 1e6);
+    }
+    else if (bps >= 1000)
+    {
+        snprintf(buffer, size, "%.1f Kbps", bps / 1e3);
+    }
+    else
+    {
+        snprintf(buffer, size, "%u bps", (unsigned)bps);
+    }
+}
+
+/*
+ * Rows read "down / up" from the users' point of view. On the uplinks that
+ * is rx / tx; on br-lan it is reversed, what the clients download is our tx.
+ */
+static void format_link_rate(int ret, const struct link_rate *rate, bool client_side, char *out)
+{
+    char rx[24], tx[24];
+
+    if (ret != 0)
+    {
+        strcpy(out, UNKNOWN_VALUE_REPLACE_STRING);
+        return;
+    }
+    format_bit_rate(rate->rx_bps, rx, sizeof(rx));
+    format_bit_rate(rate->tx_bps, tx, sizeof(tx));
+    snprintf(out, DEFAULT_VALUE_SIZE, "%s / %s", client_side ? tx : rx, client_side ? rx : tx);
+}
+
+static void update_throughput(struct metrics_snapshot *s, char *out)
+{
+    (void)out;
+    struct link_rate rate;
+    int ret = linkstats_sample();
+
+    format_link_rate(ret != 0 ? ret : linkstats_get_prefix("wwan", &rate), &rate, false, s->throughput_modem);
+    format_link_rate(ret != 0 ? ret : linkstats_get("eth1", &rate), &rate, false, s->throughput_wan);
+    format_link_rate(ret != 0 ? ret : linkstats_get("br-lan", &rate), &rate, true, s->throughput_lan);
+}
+
+/*
+ * The modem is polled quickly while the link moves (handover, reconnect)
+ * and progressively less often once it has settled. Only two good readings
+ * are compared; a modem that keeps failing is backed off instead, so a
+ * wedged AT port is not hammered.
+ */
+static uint32_t modem_poll_ms = MODEM_POLL_DEFAULT_MS;
+static struct modem_metrics modem_last;
+static bool modem_last_valid = false;
+static int modem_failures = 0; // consecutive
+
+static uint32_t modem_poll_ceiling_ms(void)
+{
+    static uint32_t ceiling_ms = 0;
+    if (ceiling_ms == 0)
+    {
+        const char *env = getenv("ZZ_MODEM_POLL_MAX");
+        int seconds = env != NULL ? atoi(env) : 0;
+        ceiling_ms = seconds > 0 ? (uint32_t)seconds * 1000 : MODEM_POLL_CEILING_MS;
+        if (ceiling_ms < MODEM_POLL_MIN_MS)
+        {
+            ceiling_ms = MODEM_POLL_MIN_MS;
+        }
+    }
+    return ceiling_ms;
+}
+
+static bool modem_volatile(const struct modem_metrics *prev, const struct modem_metrics *cur)
+{
+    if (strcmp(prev->connect, cur->connect) != 0 || strcmp(prev->networkmode, cur->networkmode) != 0)
+    {
+        return true;
+    }
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        if (strcmp(prev->signal[i].name, cur->signal[i].name) != 0 ||
+            abs(prev->signal[i].value - cur->signal[i].value) >= MODEM_SIGNAL_DELTA)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void modem_sample(struct metrics_snapshot *s)
+{
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        const struct modem_signal *sig = &s->modem.signal[i];
+        // an empty or unknown channel has an all-zero range: leave a gap
+        take_sample(s, HISTORY_SIGNAL1 + i, sig->min == 0 && sig->max == 0 ? HISTORY_NONE : sig->value,
+                    modem_poll_ms);
+    }
+}
+
+static uint32_t modem_backoff(uint32_t poll_ms)
+{
+    uint32_t ceiling_ms = modem_poll_ceiling_ms();
+    return poll_ms >= ceiling_ms / 2 ? ceiling_ms : poll_ms * 2;
+}
+
+static void modem_adapt(const struct modem_metrics *m, bool ok)
+{
+    if (!ok)
+    {
+        // the first failure keeps the rate, from the second on it halves
+        if (modem_failures++ > 0)
+        {
+            modem_poll_ms = modem_backoff(modem_poll_ms);
+        }
+        return;
+    }
+    modem_failures = 0;
+    if (modem_last_valid && modem_volatile(&modem_last, m))
+    {
+        modem_poll_ms = MODEM_POLL_MIN_MS;
+    }
+    else if (modem_last_valid)
+    {
+        modem_poll_ms = modem_backoff(modem_poll_ms);
+    }
+    modem_last = *m;
+    modem_last_valid = true;
+}
+
+static uint32_t modem_next_period(void)
+{
+    return modem_poll_ms;
+}
+
+static void update_modem(struct metrics_snapshot *s, char *out)
+{
+    (void)out;
+    int ret = modem_collect(&s->modem);
+    if (ret != 0)
+    {
+        s->modem_seq++;
+        modem_sample(s);
+        modem_adapt(&s->modem, ret > 0);
+    }
+}
+
+static int modem_reply(struct metrics_snapshot *s)
+{
+    int ret = modem_handle_event(&s->modem);
+    if (ret != 0)
+    {
+        s->modem_seq++;
+        modem_sample(s);
+        modem_adapt(&s->modem, ret > 0);
+        return 1;
+    }
+    return 0;
+}
+
+#define SLOT(field) offsetof(struct metrics_snapshot, field)
+
+const struct metric_provider metric_providers[] = {
+    // name, group, period, initial delay, cost, triggers, slot, widget, update
+    {"hostname", METRIC_GROUP_SYSTEM_INFO, 60 * 1000, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(hostname), &ui_valHostname, update_hostname},
+    {"sys_version", METRIC_GROUP_SYSTEM_INFO, METRIC_ONCE, 0, METRIC_COST_CACHED, 0,
+     SLOT(sys_version), &ui_valSysVersion, update_sys_version},
+    {"build_id", METRIC_GROUP_SYSTEM_INFO, METRIC_ONCE, 0, METRIC_COST_CACHED, 0,
+     SLOT(build_id), &ui_valBuildId, update_build_id},
+    {"kernel_version", METRIC_GROUP_SYSTEM_INFO, METRIC_ONCE, 0, METRIC_COST_CACHED, 0,
+     SLOT(kernel_version), &ui_valKernelVersion, update_kernel_version},
+    {"load_avg", METRIC_GROUP_SYSTEM_STATUS, LOAD_AVG_PERIOD_MS, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(load_avg), &ui_valLoadAvg, update_load_avg},
+    // per-core bars drawn next to the load average by cpubars.c
+    {"cpu_usage", METRIC_GROUP_SYSTEM_STATUS, 1000, 0, METRIC_COST_SYSCALL, 0,
+     METRIC_NO_SLOT, NULL, update_cpu_usage},
+    {"memory", METRIC_GROUP_SYSTEM_STATUS, MEMORY_PERIOD_MS, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(memory), &ui_valMemory, update_memory},
+    {"uptime", METRIC_GROUP_SYSTEM_STATUS, 1000, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(uptime), &ui_valUptime, update_uptime},
+    {"local_time", METRIC_GROUP_SYSTEM_STATUS, 1000, 0, METRIC_COST_CACHED, 0,
+     SLOT(local_time), &ui_valLocalTime, update_local_time},
+    // overheat is shown on every screen and exported, keep sampling it
+    {"soc_temp", METRIC_GROUP_ALWAYS, 1000, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(soc_temp), &ui_valSocTemp, update_soc_temp},
+    {"modem_ip", METRIC_GROUP_NETWORK_INFO, 1000, 0, METRIC_COST_CACHED, METRIC_TRIGGER_IFADDR,
+     SLOT(modem_ip), &ui_valModemIp, update_modem_ip},
+    {"wan_ip", METRIC_GROUP_NETWORK_INFO, 1000, 0, METRIC_COST_CACHED, METRIC_TRIGGER_IFADDR,
+     SLOT(wan_ip), &ui_valWanIp, update_wan_ip},
+    {"lan_ip", METRIC_GROUP_NETWORK_INFO, 1000, 0, METRIC_COST_CACHED, METRIC_TRIGGER_IFADDR,
+     SLOT(lan_ip), &ui_valLanIp, update_lan_ip},
+    {"active_connect", METRIC_GROUP_NETWORK_INFO, ACTIVE_CONNECT_PERIOD_MS, 0, METRIC_COST_SYSCALL, 0,
+     SLOT(active_connect), &ui_valActiveConnect, update_active_connect},
+    {"arp_count", METRIC_GROUP_NETWORK_INFO, 1000, 0, METRIC_COST_CACHED, 0,
+     SLOT(arp_count), &ui_valArpCount, update_arp_count},
+    // one link dump fills all three rows, ui_apply.c binds them
+    {"throughput", METRIC_GROUP_THROUGHPUT, 1000, 0, METRIC_COST_SYSCALL, 0,
+     METRIC_NO_SLOT, NULL, update_throughput},
+    // the modem needs some time after boot before it answers
+    {"modem", METRIC_GROUP_MODEM, MODEM_POLL_DEFAULT_MS, 20 * 1000, METRIC_COST_SUBPROCESS, 0,
+     METRIC_NO_SLOT, NULL, update_modem, modem_event_fd, modem_reply, modem_next_period,
+     modem_deadline_fd},
+};
+
+const size_t metric_provider_count = sizeof(metric_providers) / sizeof(metric_providers[0]);
+
+void metric_providers_init(void)
+{
+    update_static_value();
+    thermal_init();
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_PROVIDERS_H
+#define _XGP_V3_PROVIDERS_H
+
+#include "lvgl/lvgl.h"
+#include "metrics.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Registry of everything the collector produces. Each provider fills one
+ * snapshot slot on its own period; adding a metric means adding a function
+ * and a row to metric_providers[] in providers.c.
+ */
+
+#define METRIC_ONCE 0                 // period: collected once at startup
+#define METRIC_NO_SLOT ((size_t)-1)   // slot: provider fills several fields itself
+
+/* Within one run, cheaper providers go first and are published before a subprocess */
+enum metric_cost
+{
+    METRIC_COST_CACHED,     // in-process state, no I/O
+    METRIC_COST_SYSCALL,    // a /proc read or netlink round-trip
+    METRIC_COST_SUBPROCESS, // spawns a helper, may take seconds
+};
+
+/* Events that refresh a provider in addition to its period */
+enum metric_trigger
+{
+    METRIC_TRIGGER_IFADDR = 1 << 0, // interface address added or removed
+};
+
+struct metric_provider
+{
+    const char *name;
+    uint32_t group;            // enum metric_group, i.e. which screen shows it
+    uint32_t period_ms;        // or METRIC_ONCE
+    uint32_t initial_delay_ms; // before the first run
+    enum metric_cost cost;
+    uint32_t triggers;         // enum metric_trigger
+    size_t slot;               // offset of its string in struct metrics_snapshot
+    lv_obj_t **widget;         // label bound to the slot, NULL if the UI handles it
+    void (*update)(struct metrics_snapshot *s, char *slot);
+
+    // optional, for providers whose result arrives later on a file descriptor
+    int (*event_fd)(void);                        // -1 when nothing to watch
+    int (*on_event)(struct metrics_snapshot *s);  // 1 if s was updated
+
+    // optional, replaces period_ms for providers that adapt their rate
+    uint32_t (*next_period)(void);
+
+    // optional, a timerfd that fires when the result is overdue; calls on_event too
+    int (*deadline_fd)(void);
+};
+
+extern const struct metric_provider metric_providers[];
+extern const size_t metric_provider_count;
+
+/* Reads the values that never change at runtime; collector thread only */
+void metric_providers_init(void);
+
+#endif
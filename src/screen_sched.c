@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "screen_sched.h"
+#include "collector.h"
+#include "lvgl/lvgl.h"
+#include "ui/ui.h"
+#include <stdint.h>
+
+struct carousel_screen
+{
+    lv_obj_t **screen;
+    uint32_t groups;
+    int next; // index of the screen its ui_event_* handler changes to
+};
+
+// mirrors the _ui_screen_change() chain in ui/screens/ui_*.c
+static const struct carousel_screen carousel[] = {
+    {&ui_Boot, 0, 1},
+    {&ui_Splash, 0, 2},
+    {&ui_SystemInfo, METRIC_GROUP_SYSTEM_INFO, 3},
+    {&ui_SystemStatus, METRIC_GROUP_SYSTEM_STATUS, 4},
+    {&ui_NetworkInfo, METRIC_GROUP_NETWORK_INFO, 5},
+    {&ui_Throughput, METRIC_GROUP_THROUGHPUT, 6},
+    {&ui_ModemInfo, METRIC_GROUP_MODEM, 7},
+    {&ui_ModemSignal, METRIC_GROUP_MODEM, 2},
+};
+
+#define CAROUSEL_SIZE ((int)(sizeof(carousel) / sizeof(carousel[0])))
+
+static void screen_shown(int index)
+{
+    const struct carousel_screen *cur = &carousel[index];
+    collector_set_visible(cur->groups | carousel[cur->next].groups);
+}
+
+static void on_screen_loaded(lv_event_t *e)
+{
+    screen_shown((int)(intptr_t)lv_event_get_user_data(e));
+}
+
+void screen_sched_init(void)
+{
+    lv_obj_t *active = lv_screen_active();
+    for (int i = 0; i < CAROUSEL_SIZE; i++)
+    {
+        lv_obj_t *screen = *carousel[i].screen;
+        if (screen == NULL)
+        {
+            continue;
+        }
+        lv_obj_add_event_cb(screen, on_screen_loaded, LV_EVENT_SCREEN_LOADED, (void *)(intptr_t)i);
+        if (screen == active)
+        {
+            screen_shown(i);
+        }
+    }
+}
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_SCREEN_SCHED_H
+#define _XGP_V3_SCREEN_SCHED_H
+
+/*
+ * Tells the collector which metric groups are worth collecting: those of the
+ * screen currently shown and of the one the carousel moves to next, so its
+ * values are fresh by the time it slides in. Call after ui_init().
+ */
+void screen_sched_init(void);
+
+#endif
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "snapshot_shm.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+static struct snapshot_shm_segment *segment = NULL;
+
+int snapshot_shm_init(void)
+{
+    // a fresh file: readers still mapping the old one keep a consistent view
+    unlink(SNAPSHOT_SHM_PATH);
+    int fd = open(SNAPSHOT_SHM_PATH, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        perror("snapshot shm");
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(*segment)) < 0)
+    {
+        perror("snapshot shm");
+        close(fd);
+        unlink(SNAPSHOT_SHM_PATH);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(*segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("snapshot shm");
+        unlink(SNAPSHOT_SHM_PATH);
+        return -1;
+    }
+
+    segment = map;
+    segment->version = SNAPSHOT_SHM_VERSION;
+    segment->size = sizeof(*segment);
+    segment->writer_pid = (uint32_t)getpid();
+    segment->seq = 0;
+    // the magic stays 0 until the first publish, readers never see an empty snapshot
+    return 0;
+}
+
+void snapshot_shm_publish(const struct metrics_snapshot *snap)
+{
+    if (segment == NULL)
+    {
+        return;
+    }
+    uint32_t seq = segment->seq;
+    __atomic_store_n(&segment->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    segment->published_at = (int64_t)time(NULL);
+    memcpy(&segment->snapshot, snap, sizeof(segment->snapshot));
+    __atomic_store_n(&segment->seq, seq + 2, __ATOMIC_RELEASE);
+    if (seq == 0)
+    {
+        __atomic_store_n(&segment->magic, SNAPSHOT_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+}
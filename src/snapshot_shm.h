@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_SNAPSHOT_SHM_H
+#define _XGP_V3_SNAPSHOT_SHM_H
+
+#include "metrics.h"
+#include <stdint.h>
+
+/*
+ * Every published snapshot is also copied into a /dev/shm segment for
+ * other local readers (LuCI, scripts via zz_xgp_metrics).
+ *
+ * The segment is a header followed by struct metrics_snapshot as-is, so
+ * readers must be built from the same metrics.h; the version is bumped
+ * whenever that layout changes. Access is a seqlock: seq is odd while the
+ * collector writes, and a reader retries when seq changed during its copy.
+ * Reading takes no lock and, once mapped, no syscall unless it has to wait
+ * out a write in progress.
+ */
+
+#define SNAPSHOT_SHM_PATH "/dev/shm/zz_xgp_screen"
+#define SNAPSHOT_SHM_MAGIC 0x53504758 // "XGPS"
+#define SNAPSHOT_SHM_VERSION 2
+
+struct snapshot_shm_segment
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // of the whole segment
+    uint32_t writer_pid;
+    uint32_t seq;          // seqlock, covers the fields below
+    uint32_t reserved;
+    int64_t published_at; // wall clock, seconds
+    struct metrics_snapshot snapshot;
+};
+
+/* Writer side, collector thread only */
+int snapshot_shm_init(void);
+void snapshot_shm_publish(const struct metrics_snapshot *snap);
+
+/* Reader side, see snapshot_shm_reader.c */
+struct snapshot_shm_reader
+{
+    const struct snapshot_shm_segment *seg;
+};
+
+/* Maps the segment read-only; 0 on success, -1 if absent, not yet published or incompatible */
+int snapshot_shm_attach(struct snapshot_shm_reader *r);
+void snapshot_shm_detach(struct snapshot_shm_reader *r);
+
+/* Consistent copy of the latest snapshot; 0 on success, -1 if the writer kept it busy for 100ms */
+int snapshot_shm_read(const struct snapshot_shm_reader *r, struct metrics_snapshot *out, int64_t *published_at);
+
+#endif
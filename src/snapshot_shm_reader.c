@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "snapshot_shm.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SNAPSHOT_SHM_READ_TIMEOUT_NS (100 * 1000 * 1000L)
+#define SNAPSHOT_SHM_RETRY_PAUSE_NS (50 * 1000L) // a publish copies a few KB
+
+static int64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int snapshot_shm_attach(struct snapshot_shm_reader *r)
+{
+    struct stat st;
+
+    r->seg = NULL;
+    int fd = open(SNAPSHOT_SHM_PATH, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(*r->seg))
+    {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(*r->seg), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    const struct snapshot_shm_segment *seg = map;
+    if (__atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != SNAPSHOT_SHM_MAGIC ||
+        seg->version != SNAPSHOT_SHM_VERSION || seg->size != sizeof(*seg))
+    {
+        munmap(map, sizeof(*seg));
+        return -1;
+    }
+    r->seg = seg;
+    return 0;
+}
+
+void snapshot_shm_detach(struct snapshot_shm_reader *r)
+{
+    if (r->seg != NULL)
+    {
+        munmap((void *)r->seg, sizeof(*r->seg));
+        r->seg = NULL;
+    }
+}
+
+int snapshot_shm_read(const struct snapshot_shm_reader *r, struct metrics_snapshot *out, int64_t *published_at)
+{
+    const struct snapshot_shm_segment *seg = r->seg;
+
+    const struct timespec pause = {.tv_sec = 0, .tv_nsec = SNAPSHOT_SHM_RETRY_PAUSE_NS};
+    int64_t deadline = monotonic_ns() + SNAPSHOT_SHM_READ_TIMEOUT_NS;
+
+    for (;;)
+    {
+        uint32_t begin = __atomic_load_n(&seg->seq, __ATOMIC_ACQUIRE);
+        // an odd seq means the collector is half-way through a copy
+        if (!(begin & 1))
+        {
+            memcpy(out, &seg->snapshot, sizeof(*out));
+            if (published_at != NULL)
+            {
+                *published_at = seg->published_at;
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&seg->seq, __ATOMIC_RELAXED) == begin)
+            {
+                return 0;
+            }
+        }
+        if (monotonic_ns() >= deadline)
+        {
+            return -1;
+        }
+        // let the writer finish instead of spinning against it
+        nanosleep(&pause, NULL);
+    }
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "sparkline.h"
+#include "lvgl/lvgl.h"
+#include "ui/ui.h"
+
+#define SPARKLINE_HEIGHT 24
+
+_Static_assert(HISTORY_NONE == LV_CHART_POINT_NONE, "empty history slots must not be drawn");
+
+struct sparkline
+{
+    lv_obj_t **anchor; // label the chart sits behind
+    lv_obj_t *chart;
+    lv_chart_series_t *series;
+};
+
+static struct sparkline sparklines[HISTORY_CHANNELS] = {
+    [HISTORY_LOAD] = {&ui_valLoadAvg},
+    [HISTORY_MEMORY] = {&ui_valMemory},
+    [HISTORY_CONNTRACK] = {&ui_valActiveConnect},
+    [HISTORY_SIGNAL1] = {&ui_valModemSignalValue1},
+    [HISTORY_SIGNAL2] = {&ui_valModemSignalValue2},
+    [HISTORY_SIGNAL3] = {&ui_valModemSignalValue3},
+};
+
+static lv_obj_t *create_chart(lv_obj_t *anchor)
+{
+    lv_obj_t *chart = lv_chart_create(lv_obj_get_parent(anchor));
+    lv_obj_update_layout(anchor);
+    lv_obj_set_size(chart, lv_obj_get_width(anchor), SPARKLINE_HEIGHT);
+    lv_obj_align_to(chart, anchor, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_move_background(chart);
+    lv_obj_remove_flag(chart, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_set_style_bg_opa(chart, LV_OPA_TRANSP, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(chart, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_all(chart, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_line_width(chart, 2, LV_PART_ITEMS | LV_STATE_DEFAULT);
+    lv_obj_set_style_width(chart, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+    lv_obj_set_style_height(chart, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_point_count(chart, HISTORY_LENGTH);
+    return chart;
+}
+
+void sparkline_init(struct history *h)
+{
+    for (int ch = 0; ch < HISTORY_CHANNELS; ch++)
+    {
+        struct sparkline *s = &sparklines[ch];
+        if (s->anchor == NULL || *s->anchor == NULL)
+        {
+            continue;
+        }
+        s->chart = create_chart(*s->anchor);
+        s->series = lv_chart_add_series(s->chart, lv_palette_lighten(LV_PALETTE_BLUE, 3), LV_CHART_AXIS_PRIMARY_Y);
+        // the chart draws straight from the ring, appending never copies
+        lv_chart_set_ext_y_array(s->chart, s->series, h->samples[ch]);
+    }
+}
+
+void sparkline_update(const struct history *h, enum history_channel ch)
+{
+    struct sparkline *s = &sparklines[ch];
+    int32_t min, max;
+
+    if (s->chart == NULL)
+    {
+        return;
+    }
+    if (history_range(h, ch, &min, &max))
+    {
+        if (min == max)
+        {
+            min--;
+            max++;
+        }
+        lv_chart_set_axis_range(s->chart, LV_CHART_AXIS_PRIMARY_Y, min, max);
+    }
+    // with SHIFT mode the chart starts drawing at the oldest sample
+    lv_chart_set_x_start_point(s->chart, s->series, h->head[ch]);
+    lv_chart_refresh(s->chart);
+}
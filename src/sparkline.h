@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_SPARKLINE_H
+#define _XGP_V3_SPARKLINE_H
+
+#include "history.h"
+
+/*
+ * Small trend charts drawn behind the value labels of load, memory,
+ * connections and the modem signals. The charts read the history rings in
+ * place; call after ui_init().
+ */
+void sparkline_init(struct history *h);
+
+/* Redraws the chart of a channel after a sample has been appended */
+void sparkline_update(const struct history *h, enum history_channel ch);
+
+#endif
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#define _GNU_SOURCE // pipe2
+#include "subprocess.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#define SUBPROCESS_READ_CHUNK 4096
+#define SUBPROCESS_INITIAL_SIZE 16384
+
+extern char **environ;
+
+pid_t subprocess_spawn(char *const argv[], int flags, int *fd)
+{
+    int ends[2];
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    pid_t pid;
+
+    if (flags & SUBPROCESS_DUPLEX)
+    {
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, ends) < 0)
+        {
+            perror("socketpair");
+            return -1;
+        }
+    }
+    else
+    {
+        if (pipe2(ends, O_CLOEXEC) < 0)
+        {
+            perror("pipe2");
+            return -1;
+        }
+    }
+
+    posix_spawn_file_actions_init(&actions);
+    if (flags & SUBPROCESS_DUPLEX)
+    {
+        posix_spawn_file_actions_adddup2(&actions, ends[1], STDIN_FILENO);
+    }
+    else
+    {
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    }
+    posix_spawn_file_actions_adddup2(&actions, ends[1], STDOUT_FILENO);
+
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+
+    int ret = posix_spawn(&pid, argv[0], &actions, &attr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(ends[1]);
+    if (ret != 0)
+    {
+        fprintf(stderr, "Error: failed to start %s: %s\n", argv[0], strerror(ret));
+        close(ends[0]);
+        return -1;
+    }
+
+    fcntl(ends[0], F_SETFL, fcntl(ends[0], F_GETFL) | O_NONBLOCK);
+    *fd = ends[0];
+    return pid;
+}
+
+void subprocess_kill(pid_t pid)
+{
+    kill(-pid, SIGKILL);
+    while (waitpid(pid, NULL, 0) < 0 && errno == EINTR)
+    {
+    }
+}
+
+int subprocess_read(int fd, char **buf, size_t *cap, size_t *len)
+{
+    while (1)
+    {
+        if (*cap - *len < SUBPROCESS_READ_CHUNK)
+        {
+            size_t new_cap = *cap ? *cap * 2 : SUBPROCESS_INITIAL_SIZE;
+            char *new_buf = realloc(*buf, new_cap);
+            if (new_buf == NULL)
+            {
+                return -1;
+            }
+            *buf = new_buf;
+            *cap = new_cap;
+        }
+
+        ssize_t n = read(fd, *buf + *len, *cap - *len);
+        if (n > 0)
+        {
+            *len += (size_t)n;
+            continue;
+        }
+        if (n == 0)
+        {
+            return 1;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        return errno == EAGAIN ? 0 : -1;
+    }
+}
+
+int subprocess_reap(pid_t pid, enum subprocess_status *status)
+{
+    int wstatus;
+    pid_t ret;
+
+    while ((ret = waitpid(pid, &wstatus, WNOHANG)) < 0 && errno == EINTR)
+    {
+    }
+    if (ret == 0)
+    {
+        return 0;
+    }
+    *status = ret > 0 && WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0 ? SUBPROCESS_OK : SUBPROCESS_FAILED;
+    return 1;
+}
+
+int subprocess_pidfd(pid_t pid)
+{
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_SUBPROCESS_H
+#define _XGP_V3_SUBPROCESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/*
+ * posix_spawn() wrapper for the external commands we run. Children get their
+ * own process group, so a timeout kills whatever they started as well.
+ */
+
+enum subprocess_status
+{
+    SUBPROCESS_OK,
+    SUBPROCESS_FAILED, // could not start, or exited non-zero
+};
+
+/* stdin is /dev/null and stdout a pipe, unless SUBPROCESS_DUPLEX is given */
+#define SUBPROCESS_DUPLEX 0x1 // stdin and stdout on one socketpair end
+
+/*
+ * Starts argv[0] with stderr inherited. *fd receives our end of its stdio
+ * (non-blocking, close-on-exec). Returns the pid or -1.
+ */
+pid_t subprocess_spawn(char *const argv[], int flags, int *fd);
+
+/* SIGKILLs the child's process group and reaps it */
+void subprocess_kill(pid_t pid);
+
+/*
+ * Appends what is available on a non-blocking fd to *buf (grown with realloc
+ * as needed, *cap tracks its size). Returns 1 at EOF, 0 if more may follow,
+ * -1 on error.
+ */
+int subprocess_read(int fd, char **buf, size_t *cap, size_t *len);
+
+/* Reaps the child if it has exited: 1 with *status set, 0 while it runs */
+int subprocess_reap(pid_t pid, enum subprocess_status *status);
+
+/* An fd that becomes readable once the child exits, -1 before Linux 5.3 */
+int subprocess_pidfd(pid_t pid);
+
+#endif
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "thermal.h"
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THERMAL_CLASS_PATH "/sys/class/thermal"
+#define THERMAL_MAX_ZONES 8
+#define THERMAL_MAX_TRIPS 16
+
+struct thermal_zone
+{
+    int fd; // kept-open temp file
+    char type[24];
+    int warn_mc;
+    bool overheat;
+};
+
+static struct thermal_zone zones[THERMAL_MAX_ZONES];
+static int zone_count = 0;
+
+/* Reads a small sysfs attribute of the zone and strips the newline; length or -1 */
+static int read_attr(int zone_fd, const char *name, char *buf, size_t size)
+{
+    int fd = openat(zone_fd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    ssize_t len = read(fd, buf, size - 1);
+    close(fd);
+    if (len <= 0)
+    {
+        return -1;
+    }
+    buf[len] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+    return (int)strlen(buf);
+}
+
+/* Lowest trip point at which the zone starts throttling, or -1 */
+static int lowest_trip_mc(int zone_fd)
+{
+    int lowest = -1;
+
+    for (int i = 0; i < THERMAL_MAX_TRIPS; i++)
+    {
+        char name[32];
+        char type[16];
+        char temp[16];
+
+        snprintf(name, sizeof(name), "trip_point_%d_type", i);
+        if (read_attr(zone_fd, name, type, sizeof(type)) < 0)
+        {
+            break;
+        }
+        // "active" trips only switch on a fan, critical ones are too late
+        if (strcmp(type, "passive") != 0 && strcmp(type, "hot") != 0)
+        {
+            continue;
+        }
+        snprintf(name, sizeof(name), "trip_point_%d_temp", i);
+        if (read_attr(zone_fd, name, temp, sizeof(temp)) < 0)
+        {
+            continue;
+        }
+        int mc = atoi(temp);
+        if (mc > 0 && (lowest < 0 || mc < lowest))
+        {
+            lowest = mc;
+        }
+    }
+    return lowest;
+}
+
+int thermal_init(void)
+{
+    const char *env = getenv("ZZ_THERMAL_WARN");
+    int env_warn_mc = env != NULL ? atoi(env) * 1000 : 0;
+
+    DIR *dir = opendir(THERMAL_CLASS_PATH);
+    if (dir == NULL)
+    {
+        return 0;
+    }
+
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL && zone_count < THERMAL_MAX_ZONES)
+    {
+        if (strncmp(ent->d_name, "thermal_zone", 12) != 0)
+        {
+            continue;
+        }
+        int zone_fd = openat(dirfd(dir), ent->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (zone_fd < 0)
+        {
+            continue;
+        }
+
+        struct thermal_zone *z = &zones[zone_count];
+        z->fd = openat(zone_fd, "temp", O_RDONLY | O_CLOEXEC);
+        if (z->fd < 0)
+        {
+            close(zone_fd);
+            continue;
+        }
+        if (read_attr(zone_fd, "type", z->type, sizeof(z->type)) < 0)
+        {
+            strcpy(z->type, "thermal");
+        }
+        if (env_warn_mc > 0)
+        {
+            z->warn_mc = env_warn_mc;
+        }
+        else
+        {
+            int trip_mc = lowest_trip_mc(zone_fd);
+            z->warn_mc = trip_mc > 0 ? trip_mc : THERMAL_DEFAULT_WARN_MC;
+        }
+        z->overheat = false;
+        zone_count++;
+        close(zone_fd);
+    }
+    closedir(dir);
+    return zone_count;
+}
+
+static int read_temp_mc(const struct thermal_zone *z, int *temp_mc)
+{
+    char buf[16];
+    ssize_t len;
+
+    do
+    {
+        len = pread(z->fd, buf, sizeof(buf) - 1, 0);
+    } while (len < 0 && errno == EINTR);
+    // sensors that are not ready answer with an error (e.g. EAGAIN)
+    if (len <= 0)
+    {
+        return -1;
+    }
+    buf[len] = '\0';
+
+    const char *p = buf;
+    int sign = 1;
+    int v = 0;
+    if (*p == '-')
+    {
+        sign = -1;
+        p++;
+    }
+    if (*p < '0' || *p > '9')
+    {
+        return -1;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        v = v * 10 + (*p++ - '0');
+    }
+    *temp_mc = sign * v;
+    return 0;
+}
+
+int thermal_sample(struct thermal_reading *r)
+{
+    int found = -1;
+
+    r->overheat = false;
+    for (int i = 0; i < zone_count; i++)
+    {
+        struct thermal_zone *z = &zones[i];
+        int temp_mc;
+        if (read_temp_mc(z, &temp_mc) != 0)
+        {
+            continue;
+        }
+
+        if (temp_mc >= z->warn_mc)
+        {
+            z->overheat = true;
+        }
+        else if (temp_mc < z->warn_mc - THERMAL_HYSTERESIS_MC)
+        {
+            z->overheat = false;
+        }
+        r->overheat = r->overheat || z->overheat;
+
+        if (found < 0 || temp_mc > r->temp_mc)
+        {
+            r->temp_mc = temp_mc;
+            r->warn_mc = z->warn_mc;
+            r->type = z->type;
+            found = 0;
+        }
+    }
+    return found;
+}
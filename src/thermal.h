@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_THERMAL_H
+#define _XGP_V3_THERMAL_H
+
+#include <stdbool.h>
+
+/*
+ * SoC temperatures from /sys/class/thermal. The zones are discovered once
+ * by thermal_init() and their temp files stay open, so a sample is one
+ * pread() per zone.
+ *
+ * Each zone's warning threshold is its lowest passive/hot trip point, or
+ * ZZ_THERMAL_WARN (degrees C) when set. The overheat flag clears again
+ * THERMAL_HYSTERESIS_MC below the threshold.
+ */
+
+#define THERMAL_DEFAULT_WARN_MC 85000
+#define THERMAL_HYSTERESIS_MC 3000
+
+struct thermal_reading
+{
+    int temp_mc;      // hottest zone, millidegrees C
+    int warn_mc;      // its threshold
+    const char *type; // its type, e.g. "cpu-thermal"
+    bool overheat;    // any zone over its threshold
+};
+
+/* Returns the number of zones found */
+int thermal_init(void);
+
+/* 0 on success, -1 if no zone could be read */
+int thermal_sample(struct thermal_reading *r);
+
+#endif
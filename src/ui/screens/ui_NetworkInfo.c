@@ -25,7 +25,7 @@ void ui_event_NetworkInfo(lv_event_t * e)
     lv_event_code_t event_code = lv_event_get_code(e);
 
     if(event_code == LV_EVENT_SCREEN_LOADED) {
-        _ui_screen_change(&ui_ModemInfo, LV_SCR_LOAD_ANIM_MOVE_TOP, 200, 5000, &ui_ModemInfo_screen_init);
+        _ui_screen_change(&ui_Throughput, LV_SCR_LOAD_ANIM_MOVE_TOP, 200, 5000, &ui_Throughput_screen_init);
     }
 }
 
@@ -60,7 +60,7 @@ void ui_NetworkInfo_screen_init(void)
     lv_obj_set_width(ui_txtNetworkInfo1, lv_pct(100));
     lv_obj_set_height(ui_txtNetworkInfo1, LV_SIZE_CONTENT);    /// 1
     lv_obj_set_align(ui_txtNetworkInfo1, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_txtNetworkInfo1, "(3/5)");
+    lv_label_set_text(ui_txtNetworkInfo1, "(3/6)");
     ui_object_set_themeable_style_property(ui_txtNetworkInfo1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
                                            _ui_theme_color_default);
     ui_object_set_themeable_style_property(ui_txtNetworkInfo1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
@@ -58,7 +58,7 @@ void ui_SystemInfo_screen_init(void)
     lv_obj_set_width(ui_txtSystemInfo1, lv_pct(100));
     lv_obj_set_height(ui_txtSystemInfo1, LV_SIZE_CONTENT);    /// 1
     lv_obj_set_align(ui_txtSystemInfo1, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_txtSystemInfo1, "(1/5)");
+    lv_label_set_text(ui_txtSystemInfo1, "(1/6)");
     ui_object_set_themeable_style_property(ui_txtSystemInfo1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
                                            _ui_theme_color_default);
     ui_object_set_themeable_style_property(ui_txtSystemInfo1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
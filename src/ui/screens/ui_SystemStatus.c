@@ -9,6 +9,7 @@ lv_obj_t * ui_SystemStatus = NULL;
 lv_obj_t * ui_headerSystemStatus = NULL;
 lv_obj_t * ui_txtSystemStatus = NULL;
 lv_obj_t * ui_txtSystemStatus1 = NULL;
+lv_obj_t * ui_valSocTemp = NULL;
 lv_obj_t * ui_txtLoadAvg = NULL;
 lv_obj_t * ui_valLoadAvg = NULL;
 lv_obj_t * ui_txtMemory = NULL;
@@ -58,7 +59,7 @@ void ui_SystemStatus_screen_init(void)
     lv_obj_set_width(ui_txtSystemStatus1, lv_pct(100));
     lv_obj_set_height(ui_txtSystemStatus1, LV_SIZE_CONTENT);    /// 1
     lv_obj_set_align(ui_txtSystemStatus1, LV_ALIGN_CENTER);
-    lv_label_set_text(ui_txtSystemStatus1, "(2/5)");
+    lv_label_set_text(ui_txtSystemStatus1, "(2/6)");
     ui_object_set_themeable_style_property(ui_txtSystemStatus1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
                                            _ui_theme_color_default);
     ui_object_set_themeable_style_property(ui_txtSystemStatus1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
@@ -66,6 +67,14 @@ void ui_SystemStatus_screen_init(void)
     lv_obj_set_style_text_align(ui_txtSystemStatus1, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_font(ui_txtSystemStatus1, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
 
+    ui_valSocTemp = lv_label_create(ui_headerSystemStatus);
+    lv_obj_set_width(ui_valSocTemp, lv_pct(100));
+    lv_obj_set_height(ui_valSocTemp, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_valSocTemp, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_valSocTemp, "SoC 45.0℃");
+    lv_obj_set_style_text_align(ui_valSocTemp, LV_TEXT_ALIGN_LEFT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_valSocTemp, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     ui_txtLoadAvg = lv_label_create(ui_SystemStatus);
     lv_obj_set_width(ui_txtLoadAvg, 100);
     lv_obj_set_height(ui_txtLoadAvg, LV_SIZE_CONTENT);    /// 1
@@ -155,6 +164,7 @@ void ui_SystemStatus_screen_destroy(void)
     ui_headerSystemStatus = NULL;
     ui_txtSystemStatus = NULL;
     ui_txtSystemStatus1 = NULL;
+    ui_valSocTemp = NULL;
     ui_txtLoadAvg = NULL;
     ui_valLoadAvg = NULL;
     ui_txtMemory = NULL;
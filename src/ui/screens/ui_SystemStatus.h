@@ -18,6 +18,7 @@ extern lv_obj_t * ui_SystemStatus;
 extern lv_obj_t * ui_headerSystemStatus;
 extern lv_obj_t * ui_txtSystemStatus;
 extern lv_obj_t * ui_txtSystemStatus1;
+extern lv_obj_t * ui_valSocTemp;
 extern lv_obj_t * ui_txtLoadAvg;
 extern lv_obj_t * ui_valLoadAvg;
 extern lv_obj_t * ui_txtMemory;
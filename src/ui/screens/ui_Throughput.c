@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+// Hand-written in the style of the generated screens, NOT part of the
+// SquareLine Studio project: an export will not regenerate it. Keep this
+// file and its entries in ui.c, ui.h, filelist.txt and CMakeLists.txt when
+// re-exporting the UI.
+
+#include "../ui.h"
+
+lv_obj_t * ui_Throughput = NULL;
+lv_obj_t * ui_headerThroughput = NULL;
+lv_obj_t * ui_txtThroughput = NULL;
+lv_obj_t * ui_txtThroughput1 = NULL;
+lv_obj_t * ui_txtThroughputModem = NULL;
+lv_obj_t * ui_valThroughputModem = NULL;
+lv_obj_t * ui_txtThroughputWan = NULL;
+lv_obj_t * ui_valThroughputWan = NULL;
+lv_obj_t * ui_txtThroughputLan = NULL;
+lv_obj_t * ui_valThroughputLan = NULL;
+lv_obj_t * ui_txtThroughputDirection = NULL;
+lv_obj_t * ui_valThroughputDirection = NULL;
+// event funtions
+void ui_event_Throughput(lv_event_t * e)
+{
+    lv_event_code_t event_code = lv_event_get_code(e);
+
+    if(event_code == LV_EVENT_SCREEN_LOADED) {
+        _ui_screen_change(&ui_ModemInfo, LV_SCR_LOAD_ANIM_MOVE_TOP, 200, 5000, &ui_ModemInfo_screen_init);
+    }
+}
+
+// build funtions
+
+void ui_Throughput_screen_init(void)
+{
+    ui_Throughput = lv_obj_create(NULL);
+    lv_obj_remove_flag(ui_Throughput, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    ui_headerThroughput = lv_obj_create(ui_Throughput);
+    lv_obj_set_width(ui_headerThroughput, 320);
+    lv_obj_set_height(ui_headerThroughput, 30);
+    lv_obj_set_x(ui_headerThroughput, 0);
+    lv_obj_set_y(ui_headerThroughput, -70);
+    lv_obj_set_align(ui_headerThroughput, LV_ALIGN_CENTER);
+    lv_obj_remove_flag(ui_headerThroughput, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+
+    ui_txtThroughput = lv_label_create(ui_headerThroughput);
+    lv_obj_set_width(ui_txtThroughput, lv_pct(100));
+    lv_obj_set_height(ui_txtThroughput, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_txtThroughput, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughput, "流量统计");
+    ui_object_set_themeable_style_property(ui_txtThroughput, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
+                                           _ui_theme_color_default);
+    ui_object_set_themeable_style_property(ui_txtThroughput, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
+                                           _ui_theme_alpha_default);
+    lv_obj_set_style_text_align(ui_txtThroughput, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughput, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_txtThroughput1 = lv_label_create(ui_headerThroughput);
+    lv_obj_set_width(ui_txtThroughput1, lv_pct(100));
+    lv_obj_set_height(ui_txtThroughput1, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_txtThroughput1, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughput1, "(4/6)");
+    ui_object_set_themeable_style_property(ui_txtThroughput1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR,
+                                           _ui_theme_color_default);
+    ui_object_set_themeable_style_property(ui_txtThroughput1, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA,
+                                           _ui_theme_alpha_default);
+    lv_obj_set_style_text_align(ui_txtThroughput1, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughput1, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_txtThroughputModem = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_txtThroughputModem, 100);
+    lv_obj_set_height(ui_txtThroughputModem, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_txtThroughputModem, -100);
+    lv_obj_set_y(ui_txtThroughputModem, -30);
+    lv_obj_set_align(ui_txtThroughputModem, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughputModem, "Modem: ");
+    lv_obj_set_style_text_align(ui_txtThroughputModem, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughputModem, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_valThroughputModem = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_valThroughputModem, 200);
+    lv_obj_set_height(ui_valThroughputModem, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_valThroughputModem, 50);
+    lv_obj_set_y(ui_valThroughputModem, -30);
+    lv_obj_set_align(ui_valThroughputModem, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_valThroughputModem, "0.0 Mbps / 0.0 Mbps");
+    lv_obj_set_style_text_font(ui_valThroughputModem, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_txtThroughputWan = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_txtThroughputWan, 100);
+    lv_obj_set_height(ui_txtThroughputWan, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_txtThroughputWan, -100);
+    lv_obj_set_y(ui_txtThroughputWan, 0);
+    lv_obj_set_align(ui_txtThroughputWan, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughputWan, "WAN: ");
+    lv_obj_set_style_text_align(ui_txtThroughputWan, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughputWan, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_valThroughputWan = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_valThroughputWan, 200);
+    lv_obj_set_height(ui_valThroughputWan, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_valThroughputWan, 50);
+    lv_obj_set_y(ui_valThroughputWan, 0);
+    lv_obj_set_align(ui_valThroughputWan, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_valThroughputWan, "0.0 Mbps / 0.0 Mbps");
+    lv_obj_set_style_text_font(ui_valThroughputWan, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_txtThroughputLan = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_txtThroughputLan, 100);
+    lv_obj_set_height(ui_txtThroughputLan, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_txtThroughputLan, -100);
+    lv_obj_set_y(ui_txtThroughputLan, 30);
+    lv_obj_set_align(ui_txtThroughputLan, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughputLan, "LAN: ");
+    lv_obj_set_style_text_align(ui_txtThroughputLan, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughputLan, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_valThroughputLan = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_valThroughputLan, 200);
+    lv_obj_set_height(ui_valThroughputLan, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_valThroughputLan, 50);
+    lv_obj_set_y(ui_valThroughputLan, 30);
+    lv_obj_set_align(ui_valThroughputLan, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_valThroughputLan, "0.0 Mbps / 0.0 Mbps");
+    lv_obj_set_style_text_font(ui_valThroughputLan, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_txtThroughputDirection = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_txtThroughputDirection, 100);
+    lv_obj_set_height(ui_txtThroughputDirection, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_txtThroughputDirection, -100);
+    lv_obj_set_y(ui_txtThroughputDirection, 60);
+    lv_obj_set_align(ui_txtThroughputDirection, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_txtThroughputDirection, "方向: ");
+    lv_obj_set_style_text_align(ui_txtThroughputDirection, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_txtThroughputDirection, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_valThroughputDirection = lv_label_create(ui_Throughput);
+    lv_obj_set_width(ui_valThroughputDirection, 200);
+    lv_obj_set_height(ui_valThroughputDirection, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_valThroughputDirection, 50);
+    lv_obj_set_y(ui_valThroughputDirection, 60);
+    lv_obj_set_align(ui_valThroughputDirection, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_valThroughputDirection, "下行 / 上行");
+    lv_obj_set_style_text_font(ui_valThroughputDirection, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    lv_obj_add_event_cb(ui_Throughput, ui_event_Throughput, LV_EVENT_ALL, NULL);
+
+}
+
+void ui_Throughput_screen_destroy(void)
+{
+    if(ui_Throughput) lv_obj_del(ui_Throughput);
+
+    // NULL screen variables
+    ui_Throughput = NULL;
+    ui_headerThroughput = NULL;
+    ui_txtThroughput = NULL;
+    ui_txtThroughput1 = NULL;
+    ui_txtThroughputModem = NULL;
+    ui_valThroughputModem = NULL;
+    ui_txtThroughputWan = NULL;
+    ui_valThroughputWan = NULL;
+    ui_txtThroughputLan = NULL;
+    ui_valThroughputLan = NULL;
+    ui_txtThroughputDirection = NULL;
+    ui_valThroughputDirection = NULL;
+
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+// Hand-written in the style of the generated screens, NOT part of the
+// SquareLine Studio project: an export will not regenerate it. Keep this
+// file and its entries in ui.c, ui.h, filelist.txt and CMakeLists.txt when
+// re-exporting the UI.
+
+#ifndef UI_THROUGHPUT_H
+#define UI_THROUGHPUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SCREEN: ui_Throughput
+extern void ui_Throughput_screen_init(void);
+extern void ui_Throughput_screen_destroy(void);
+extern void ui_event_Throughput(lv_event_t * e);
+extern lv_obj_t * ui_Throughput;
+extern lv_obj_t * ui_headerThroughput;
+extern lv_obj_t * ui_txtThroughput;
+extern lv_obj_t * ui_txtThroughput1;
+extern lv_obj_t * ui_txtThroughputModem;
+extern lv_obj_t * ui_valThroughputModem;
+extern lv_obj_t * ui_txtThroughputWan;
+extern lv_obj_t * ui_valThroughputWan;
+extern lv_obj_t * ui_txtThroughputLan;
+extern lv_obj_t * ui_valThroughputLan;
+extern lv_obj_t * ui_txtThroughputDirection;
+extern lv_obj_t * ui_valThroughputDirection;
+// CUSTOM VARIABLES
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
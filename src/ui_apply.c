@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "ui_apply.h"
+#include "ui/ui.h"
+#include "cpubars.h"
+#include "history.h"
+#include "providers.h"
+#include "sparkline.h"
+#include "ui_bind.h"
+#include <stddef.h>
+
+#define MAX_PROVIDER_BINDINGS 32
+
+struct provider_binding
+{
+    struct label_binding binding;
+    size_t slot; // of the string in struct metrics_snapshot
+};
+
+static struct provider_binding provider_bindings[MAX_PROVIDER_BINDINGS];
+static size_t provider_binding_count = 0;
+
+/* One binding per registry entry that names a label */
+static void bind_providers(void)
+{
+    for (size_t i = 0; i < metric_provider_count && provider_binding_count < MAX_PROVIDER_BINDINGS; i++)
+    {
+        const struct metric_provider *p = &metric_providers[i];
+        if (p->widget != NULL && p->slot != METRIC_NO_SLOT)
+        {
+            struct provider_binding *b = &provider_bindings[provider_binding_count++];
+            b->binding.label = p->widget;
+            b->slot = p->slot;
+        }
+    }
+}
+
+static struct label_binding bind_throughput_modem = LABEL_BINDING_INIT(ui_valThroughputModem);
+static struct label_binding bind_throughput_wan = LABEL_BINDING_INIT(ui_valThroughputWan);
+static struct label_binding bind_throughput_lan = LABEL_BINDING_INIT(ui_valThroughputLan);
+
+static struct label_binding bind_modem_rev = LABEL_BINDING_INIT(ui_valModemRev);
+static struct label_binding bind_modem_temperature = LABEL_BINDING_INIT(ui_valModemTempature);
+static struct label_binding bind_modem_voltage = LABEL_BINDING_INIT(ui_valModemVoltage);
+static struct label_binding bind_modem_isp = LABEL_BINDING_INIT(ui_valModemISP);
+static struct label_binding bind_modem_networkmode = LABEL_BINDING_INIT(ui_valModemNetworkType);
+static struct label_binding bind_modem_cqi = LABEL_BINDING_INIT(ui_valModemCQI);
+static struct label_binding bind_modem_ambr = LABEL_BINDING_INIT(ui_valModemAmbr);
+
+static struct label_binding bind_signal_names[MODEM_SIGNAL_COUNT] = {
+    LABEL_BINDING_INIT(ui_valModemSignalName1),
+    LABEL_BINDING_INIT(ui_valModemSignalName2),
+    LABEL_BINDING_INIT(ui_valModemSignalName3),
+};
+static struct label_binding bind_signal_values[MODEM_SIGNAL_COUNT] = {
+    LABEL_BINDING_INIT(ui_valModemSignalValue1),
+    LABEL_BINDING_INIT(ui_valModemSignalValue2),
+    LABEL_BINDING_INIT(ui_valModemSignalValue3),
+};
+static struct bar_binding bind_signal_bars[MODEM_SIGNAL_COUNT] = {
+    BAR_BINDING_INIT(ui_valModemSignalBar1),
+    BAR_BINDING_INIT(ui_valModemSignalBar2),
+    BAR_BINDING_INIT(ui_valModemSignalBar3),
+};
+
+static void apply_modem_snapshot(const struct modem_metrics *m)
+{
+    ui_bind_label(&bind_modem_rev, m->revision);
+    ui_bind_label(&bind_modem_temperature, m->temperature);
+    ui_bind_label(&bind_modem_voltage, m->voltage);
+    ui_bind_label(&bind_modem_isp, m->isp);
+    ui_bind_label(&bind_modem_networkmode, m->networkmode);
+    ui_bind_label(&bind_modem_cqi, m->cqi);
+    ui_bind_label(&bind_modem_ambr, m->ambr);
+
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        const struct modem_signal *s = &m->signal[i];
+        ui_bind_label(&bind_signal_names[i], s->name);
+        ui_bind_label(&bind_signal_values[i], s->unit);
+        ui_bind_bar(&bind_signal_bars[i], s->min, s->max, s->value);
+    }
+}
+
+static bool applied_overheat = false;
+static lv_obj_t *overheat_badge; // on the top layer, so every screen shows it
+
+static void create_overheat_badge(void)
+{
+    overheat_badge = lv_label_create(lv_layer_top());
+    lv_label_set_text(overheat_badge, "SoC 过热");
+    lv_obj_set_style_text_font(overheat_badge, &ui_font_MiSans16, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_color(overheat_badge, lv_color_white(), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(overheat_badge, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(overheat_badge, LV_OPA_COVER, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_hor(overheat_badge, 4, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_radius(overheat_badge, 4, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(overheat_badge, LV_ALIGN_BOTTOM_RIGHT, -4, -4);
+    lv_obj_add_flag(overheat_badge, LV_OBJ_FLAG_HIDDEN);
+}
+
+/*
+ * Overheating turns the temperature red and shows a badge over whichever
+ * screen is up, until the zone has cooled down
+ */
+static void apply_overheat(bool overheat)
+{
+    if (overheat == applied_overheat)
+    {
+        return;
+    }
+    applied_overheat = overheat;
+    if (overheat)
+    {
+        lv_obj_remove_flag(overheat_badge, LV_OBJ_FLAG_HIDDEN);
+    }
+    else
+    {
+        lv_obj_add_flag(overheat_badge, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (ui_valSocTemp == NULL)
+    {
+        return;
+    }
+    if (overheat)
+    {
+        lv_obj_set_style_text_color(ui_valSocTemp, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN | LV_STATE_DEFAULT);
+    }
+    else
+    {
+        lv_obj_remove_local_style_prop(ui_valSocTemp, LV_STYLE_TEXT_COLOR, LV_PART_MAIN | LV_STATE_DEFAULT);
+    }
+}
+
+static uint32_t applied_modem_seq = 0;
+static uint32_t applied_sample_seq[HISTORY_CHANNELS];
+static uint64_t applied_sample_ms[HISTORY_CHANNELS];
+static struct history metric_history;
+
+/* Leaves a gap for every sample period that passed without a sample we saw */
+static void append_sample(const struct metrics_snapshot *snap, enum history_channel ch)
+{
+    uint32_t period_ms = snap->sample_period_ms[ch];
+    if (applied_sample_ms[ch] != 0 && period_ms != 0 && snap->sample_ms[ch] > applied_sample_ms[ch])
+    {
+        uint64_t periods = (snap->sample_ms[ch] - applied_sample_ms[ch] + period_ms / 2) / period_ms;
+        for (uint64_t i = 1; i < periods && i <= HISTORY_LENGTH; i++)
+        {
+            history_append(&metric_history, ch, HISTORY_NONE);
+        }
+    }
+    applied_sample_ms[ch] = snap->sample_ms[ch];
+    history_append(&metric_history, ch, snap->samples[ch]);
+}
+
+void ui_apply_snapshot(const struct metrics_snapshot *snap)
+{
+    for (size_t i = 0; i < provider_binding_count; i++)
+    {
+        struct provider_binding *b = &provider_bindings[i];
+        ui_bind_label(&b->binding, (const char *)snap + b->slot);
+    }
+    ui_bind_label(&bind_throughput_modem, snap->throughput_modem);
+    ui_bind_label(&bind_throughput_wan, snap->throughput_wan);
+    ui_bind_label(&bind_throughput_lan, snap->throughput_lan);
+    cpubars_update(snap->cpu, snap->cpu_count);
+    apply_overheat(snap->overheat);
+
+    if (snap->modem_seq != applied_modem_seq)
+    {
+        applied_modem_seq = snap->modem_seq;
+        apply_modem_snapshot(&snap->modem);
+    }
+
+    for (int ch = 0; ch < HISTORY_CHANNELS; ch++)
+    {
+        if (snap->sample_seq[ch] != applied_sample_seq[ch])
+        {
+            applied_sample_seq[ch] = snap->sample_seq[ch];
+            append_sample(snap, ch);
+            sparkline_update(&metric_history, ch);
+        }
+    }
+}
+
+void ui_apply_init(void)
+{
+    bind_providers();
+    history_init(&metric_history);
+    sparkline_init(&metric_history);
+    create_overheat_badge();
+}
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_UI_APPLY_H
+#define _XGP_V3_UI_APPLY_H
+
+#include "metrics.h"
+
+/* Binds the widgets of the provider registry; call after ui_init() */
+void ui_apply_init(void);
+
+/* Pushes a snapshot into the widgets, skipping values that did not change */
+void ui_apply_snapshot(const struct metrics_snapshot *snap);
+
+#endif
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#include "ui_bind.h"
+#include <string.h>
+
+static struct ui_bind_stats stats;
+
+void ui_bind_label(struct label_binding *b, const char *text)
+{
+    lv_obj_t *label = *b->label;
+    if (label == NULL)
+    {
+        return;
+    }
+    if (b->valid && strncmp(b->last, text, sizeof(b->last)) == 0)
+    {
+        stats.skipped++;
+        return;
+    }
+
+    lv_label_set_text(label, text);
+    strncpy(b->last, text, sizeof(b->last) - 1);
+    b->last[sizeof(b->last) - 1] = '\0';
+    // a text longer than the cache can never compare equal, keep applying it
+    b->valid = strlen(text) < sizeof(b->last);
+    stats.applied++;
+}
+
+void ui_bind_bar(struct bar_binding *b, int32_t min, int32_t max, int32_t value)
+{
+    lv_obj_t *bar = *b->bar;
+    if (bar == NULL)
+    {
+        return;
+    }
+    if (b->valid && b->min == min && b->max == max && b->value == value)
+    {
+        stats.skipped++;
+        return;
+    }
+
+    if (!b->valid || b->min != min || b->max != max)
+    {
+        lv_bar_set_range(bar, min, max);
+    }
+    lv_bar_set_value(bar, value, LV_ANIM_OFF);
+    b->min = min;
+    b->max = max;
+    b->value = value;
+    b->valid = true;
+    stats.applied++;
+}
+
+void ui_bind_invalidate_label(struct label_binding *b)
+{
+    b->valid = false;
+}
+
+void ui_bind_invalidate_bar(struct bar_binding *b)
+{
+    b->valid = false;
+}
+
+const struct ui_bind_stats *ui_bind_get_stats(void)
+{
+    return &stats;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+#ifndef _XGP_V3_UI_BIND_H
+#define _XGP_V3_UI_BIND_H
+
+#include "lvgl/lvgl.h"
+#include "metrics.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Bindings remember the last value pushed to a widget, so a snapshot that
+ * repeats it does not reallocate the label text or invalidate its area
+ * (and therefore does not cause a redraw and a flush to the panel).
+ *
+ * The widget is referenced through its ui_* global, which ui_init() fills
+ * in after the binding tables have been initialised.
+ */
+
+struct label_binding
+{
+    lv_obj_t **label;
+    bool valid;
+    char last[DEFAULT_VALUE_SIZE];
+};
+
+struct bar_binding
+{
+    lv_obj_t **bar;
+    bool valid;
+    int32_t min;
+    int32_t max;
+    int32_t value;
+};
+
+#define LABEL_BINDING_INIT(obj) {.label = &(obj)}
+#define BAR_BINDING_INIT(obj) {.bar = &(obj)}
+
+struct ui_bind_stats
+{
+    uint32_t applied;
+    uint32_t skipped;
+};
+
+void ui_bind_label(struct label_binding *b, const char *text);
+void ui_bind_bar(struct bar_binding *b, int32_t min, int32_t max, int32_t value);
+
+/* Forget the remembered values, e.g. after a screen has been recreated */
+void ui_bind_invalidate_label(struct label_binding *b);
+void ui_bind_invalidate_bar(struct bar_binding *b);
+
+const struct ui_bind_stats *ui_bind_get_stats(void);
+
+#endif
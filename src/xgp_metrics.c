@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 zzzz0317
+
+/*
+ * zz_xgp_metrics: prints what zz_xgp_screen last published to /dev/shm.
+ *
+ *   zz_xgp_metrics              all fields as shell assignments (eval-able)
+ *   zz_xgp_metrics FIELD...     just the values, one per line
+ */
+
+#include "snapshot_shm.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIELD(name) {#name, offsetof(struct metrics_snapshot, name)}
+#define MODEM_FIELD(name, member) {name, offsetof(struct metrics_snapshot, modem.member)}
+
+struct text_field
+{
+    const char *name;
+    size_t offset;
+};
+
+static const struct text_field text_fields[] = {
+    FIELD(hostname),
+    FIELD(sys_version),
+    FIELD(build_id),
+    FIELD(kernel_version),
+    FIELD(load_avg),
+    FIELD(memory),
+    FIELD(uptime),
+    FIELD(local_time),
+    FIELD(soc_temp),
+    FIELD(modem_ip),
+    FIELD(wan_ip),
+    FIELD(lan_ip),
+    FIELD(active_connect),
+    FIELD(arp_count),
+    FIELD(throughput_modem),
+    FIELD(throughput_wan),
+    FIELD(throughput_lan),
+    MODEM_FIELD("modem_revision", revision),
+    MODEM_FIELD("modem_temperature", temperature),
+    MODEM_FIELD("modem_voltage", voltage),
+    MODEM_FIELD("modem_connect", connect),
+    MODEM_FIELD("modem_sim", sim),
+    MODEM_FIELD("modem_isp", isp),
+    MODEM_FIELD("modem_cqi", cqi),
+    MODEM_FIELD("modem_ambr", ambr),
+    MODEM_FIELD("modem_network_mode", networkmode),
+};
+
+#define TEXT_FIELD_COUNT (sizeof(text_fields) / sizeof(text_fields[0]))
+#define MAX_FIELDS 96
+
+struct field_value
+{
+    char name[32];
+    char value[DEFAULT_VALUE_SIZE];
+};
+
+static struct field_value values[MAX_FIELDS];
+static int value_count = 0;
+
+static void add_value(const char *name, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+static void add_value(const char *name, const char *fmt, ...)
+{
+    va_list ap;
+    if (value_count >= MAX_FIELDS)
+    {
+        return;
+    }
+    struct field_value *v = &values[value_count++];
+    snprintf(v->name, sizeof(v->name), "%s", name);
+    va_start(ap, fmt);
+    vsnprintf(v->value, sizeof(v->value), fmt, ap);
+    va_end(ap);
+}
+
+static void collect_values(const struct metrics_snapshot *s, long long published_at)
+{
+    char name[32];
+
+    add_value("seq", "%u", s->seq);
+    add_value("published_at", "%lld", published_at);
+    for (size_t i = 0; i < TEXT_FIELD_COUNT; i++)
+    {
+        add_value(text_fields[i].name, "%s", (const char *)s + text_fields[i].offset);
+    }
+    add_value("soc_temp_mc", "%d", s->soc_temp_mc);
+    add_value("overheat", "%d", s->overheat ? 1 : 0);
+    add_value("cpu_count", "%d", s->cpu_count);
+    for (int i = 0; i < s->cpu_count && i < CPU_CORE_SLOTS; i++)
+    {
+        snprintf(name, sizeof(name), "cpu%d_busy", i);
+        add_value(name, "%u", s->cpu[i].busy);
+        snprintf(name, sizeof(name), "cpu%d_softirq", i);
+        add_value(name, "%u", s->cpu[i].softirq);
+    }
+    for (int i = 0; i < MODEM_SIGNAL_COUNT; i++)
+    {
+        const struct modem_signal *sig = &s->modem.signal[i];
+        snprintf(name, sizeof(name), "signal%d_name", i + 1);
+        add_value(name, "%s", sig->name);
+        snprintf(name, sizeof(name), "signal%d_value", i + 1);
+        add_value(name, "%d", sig->value);
+        snprintf(name, sizeof(name), "signal%d_min", i + 1);
+        add_value(name, "%d", sig->min);
+        snprintf(name, sizeof(name), "signal%d_max", i + 1);
+        add_value(name, "%d", sig->max);
+        snprintf(name, sizeof(name), "signal%d_text", i + 1);
+        add_value(name, "%s", sig->unit);
+    }
+}
+
+static const struct field_value *find_value(const char *name)
+{
+    for (int i = 0; i < value_count; i++)
+    {
+        if (strcmp(values[i].name, name) == 0)
+        {
+            return &values[i];
+        }
+    }
+    return NULL;
+}
+
+/* NAME='value' with embedded quotes closed and escaped */
+static void print_assignment(const struct field_value *v)
+{
+    printf("%s='", v->name);
+    for (const char *c = v->value; *c != '\0'; c++)
+    {
+        if (*c == '\'')
+        {
+            fputs("'\\''", stdout);
+        }
+        else
+        {
+            putchar(*c);
+        }
+    }
+    printf("'\n");
+}
+
+int main(int argc, char **argv)
+{
+    struct snapshot_shm_reader reader;
+    static struct metrics_snapshot snap;
+    int64_t published_at;
+
+    if (snapshot_shm_attach(&reader) != 0)
+    {
+        fprintf(stderr, "zz_xgp_metrics: %s is missing, not yet published or from another version\n", SNAPSHOT_SHM_PATH);
+        return 1;
+    }
+    if (snapshot_shm_read(&reader, &snap, &published_at) != 0)
+    {
+        fprintf(stderr, "zz_xgp_metrics: snapshot kept changing, try again\n");
+        return 1;
+    }
+    snapshot_shm_detach(&reader);
+    collect_values(&snap, (long long)published_at);
+
+    if (argc < 2)
+    {
+        for (int i = 0; i < value_count; i++)
+        {
+            print_assignment(&values[i]);
+        }
+        return 0;
+    }
+
+    int ret = 0;
+    for (int a = 1; a < argc; a++)
+    {
+        const struct field_value *v = find_value(argv[a]);
+        if (v == NULL)
+        {
+            fprintf(stderr, "zz_xgp_metrics: unknown field %s\n", argv[a]);
+            ret = 1;
+            continue;
+        }
+        printf("%s\n", v->value);
+    }
+    return ret;
+}